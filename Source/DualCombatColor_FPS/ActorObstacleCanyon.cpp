@@ -4,6 +4,9 @@
 #include "ActorObstacleCanyon.h"
 #include "Engine/World.h"
 #include "DualCombatColor_FPSProjectile.h"
+#include "ProjectilePoolSubsystem.h"
+#include "BulkProjectileSubsystem.h"
+#include "SignificanceTickSubsystem.h"
 
 // Sets default values
 AActorObstacleCanyon::AActorObstacleCanyon()
@@ -17,7 +20,32 @@ AActorObstacleCanyon::AActorObstacleCanyon()
 void AActorObstacleCanyon::BeginPlay()
 {
 	Super::BeginPlay();
+	UProjectilePoolSubsystem* projectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	if (projectilePool != nullptr && !bBulkProjectiles)
+	{
+		projectilePool->Prewarm(Projectile, projectilePoolSize);
+	}
 	CheckShoot();
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->RegisterActor(this);
+	}
+}
+
+void AActorObstacleCanyon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		timingWheel->ClearTimer(shootTimerHandle);
+	}
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->UnregisterActor(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -28,13 +56,34 @@ void AActorObstacleCanyon::Tick(float DeltaTime)
 }
 void AActorObstacleCanyon::CheckShoot() 
 {
-	FTimerHandle UnsedHandle;
-	GetWorldTimerManager().SetTimer(UnsedHandle, this, &AActorObstacleCanyon::Shoot, delayShoot, true);
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		// Los canones con el mismo delayShoot se reparten en el periodo para no disparar todos en el mismo frame
+		timingWheel->ClearTimer(shootTimerHandle);
+		shootTimerHandle = timingWheel->SetTimer(this, &AActorObstacleCanyon::Shoot, delayShoot, true, INDEX_NONE, true);
+	}
 }
 void AActorObstacleCanyon::Shoot() 
 {
-	ADualCombatColor_FPSProjectile* RefProjectile;
-	RefProjectile = GetWorld()->SpawnActor<ADualCombatColor_FPSProjectile>(Projectile, GetActorLocation(), GetActorRotation());
-	RefProjectile->bShooterPlayer = false;
+	if (bBulkProjectiles)
+	{
+		UBulkProjectileSubsystem* bulkProjectiles = GetWorld()->GetSubsystem<UBulkProjectileSubsystem>();
+		if (bulkProjectiles != nullptr)
+		{
+			bulkProjectiles->FireProjectile(Projectile, bulkProjectileMesh, GetActorLocation(), GetActorRotation(), false, this);
+		}
+		return;
+	}
+	UProjectilePoolSubsystem* projectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	if (projectilePool == nullptr)
+	{
+		return;
+	}
+	ADualCombatColor_FPSProjectile* RefProjectile = projectilePool->AcquireProjectile(Projectile, GetActorLocation(), GetActorRotation());
+	if (RefProjectile != nullptr)
+	{
+		RefProjectile->bShooterPlayer = false;
+	}
 }
 
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "GameplayTimingWheelSubsystem.h"
 #include "ActorObstacleCanyon.generated.h"
 
 class ADualCombatColor_FPSProjectile;
+class UStaticMesh;
 
 UCLASS()
 class DUALCOMBATCOLOR_FPS_API AActorObstacleCanyon : public AActor
@@ -23,10 +25,26 @@ public:
 
 	UPROPERTY(EditAnywhere)
 		float delayShoot;
+
+	/** Projectiles created for this canyon's class when the level starts. */
+	UPROPERTY(EditAnywhere)
+		int32 projectilePoolSize = 8;
+
+	/** Fire through UBulkProjectileSubsystem instead of one actor per bullet. */
+	UPROPERTY(EditAnywhere)
+		bool bBulkProjectiles = false;
+
+	/** Mesh drawn for every bullet in bulk mode. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "bBulkProjectiles"))
+		UStaticMesh* bulkProjectileMesh;
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	FGameplayTimerHandle shootTimerHandle;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
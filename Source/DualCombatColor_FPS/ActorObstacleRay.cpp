@@ -4,67 +4,116 @@
 #include "ActorObstacleRay.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "GameFramework/PlayerController.h"
 #include "DualCombatColor_FPSCharacter.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInterface.h"
 #include "Components/StaticMeshComponent.h"
-#include "UI_PlayerWidget.h"
+#include "HealthComponent.h"
+#include "RayObstacleSubsystem.h"
+#include "GameplayRoleActor.h"
+#include "CheckpointSubsystem.h"
 
 // Sets default values
 AActorObstacleRay::AActorObstacleRay()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Las trazas las hace URayObstacleSubsystem, este actor no necesita Tick
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 // Called when the game starts or when spawned
 void AActorObstacleRay::BeginPlay()
 {
 	Super::BeginPlay();
-	
+	URayObstacleSubsystem* rayObstacles = GetWorld()->GetSubsystem<URayObstacleSubsystem>();
+	if (rayObstacles != nullptr)
+	{
+		rayObstacles->RegisterRay(this);
+	}
 }
 
-// Called every frame
-void AActorObstacleRay::Tick(float DeltaTime)
+void AActorObstacleRay::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-	CheckShootRay();
-	
+	URayObstacleSubsystem* rayObstacles = GetWorld()->GetSubsystem<URayObstacleSubsystem>();
+	if (rayObstacles != nullptr)
+	{
+		rayObstacles->UnregisterRay(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
-void AActorObstacleRay::CheckShootRay()
+
+void AActorObstacleRay::ActivateRay()
 {
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	if (bRayActive)
+	{
+		return;
+	}
+	bRayActive = true;
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	URayObstacleSubsystem* rayObstacles = GetWorld()->GetSubsystem<URayObstacleSubsystem>();
+	if (rayObstacles != nullptr)
+	{
+		rayObstacles->RegisterRay(this);
+	}
+}
 
-	const FVector& StartPosition = GetActorLocation();
-	FVector EndPosition = GetActorLocation() + GetActorUpVector() * TraceDistance;
+void AActorObstacleRay::DeactivateRay()
+{
+	if (!bRayActive)
+	{
+		return;
+	}
+	bRayActive = false;
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	URayObstacleSubsystem* rayObstacles = GetWorld()->GetSubsystem<URayObstacleSubsystem>();
+	if (rayObstacles != nullptr)
+	{
+		rayObstacles->UnregisterRay(this);
+	}
+}
 
-	FHitResult HitResult;
-	if (GetWorld()->LineTraceSingleByChannel(HitResult, StartPosition, EndPosition, TraceChannel, QueryParams))
+FVector AActorObstacleRay::GetRayStart() const
+{
+	return GetActorLocation();
+}
+
+FVector AActorObstacleRay::GetRayEnd() const
+{
+	return GetActorLocation() + GetActorUpVector() * TraceDistance;
+}
+
+FVector AActorObstacleRay::GetClosestRayPoint(const FVector& location) const
+{
+	return FMath::ClosestPointOnSegment(location, GetRayStart(), GetRayEnd());
+}
+
+void AActorObstacleRay::ApplyRayHit(const FHitResult& HitResult)
+{
+	if (HitResult.Actor.IsValid())
 	{
-		if (HitResult.Actor.IsValid())
+		if (EnumHasAnyFlags(IGameplayRoleActor::GetActorRoles(HitResult.GetActor()), EGameplayRole::Player))
 		{
-			if (HitResult.GetActor()->Tags[0] == FName(TEXT("Player")))
+			UHealthComponent* health = HitResult.GetActor()->FindComponentByClass<UHealthComponent>();
+			if (health != nullptr)
 			{
-				ADualCombatColor_FPSCharacter* Player = Cast<ADualCombatColor_FPSCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
-				if (Player != nullptr)
-				{
-					Player->FdataPlayer.life = Player->FdataPlayer.life - Damage;
-					Player->UI_PlayerWidget->SetCurrentLifeText(Player->FdataPlayer.life);
+				health->ApplyDamage((int32)Damage, this);
 
-					Destroy();
-				}
-				else
+				// Se apaga en vez de destruirse, el checkpoint lo vuelve a prender si el jugador muere
+				DeactivateRay();
+				UCheckpointSubsystem* checkpoints = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+				if (checkpoints != nullptr)
 				{
-					UE_LOG(LogTemp, Warning, TEXT("Player de ActorObstacleRay Nulo"));
+					checkpoints->RecordDisabledRay(this);
 				}
-				//ADualCombatColor_FPSCharacter* Player = Cast<ADualCombatColor_FPSCharacter>(HitResult.GetActor());
-				UE_LOG(LogTemp, Warning, TEXT("Hit Jugador"));
 			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Player de ActorObstacleRay Nulo"));
+			}
+			//ADualCombatColor_FPSCharacter* Player = Cast<ADualCombatColor_FPSCharacter>(HitResult.GetActor());
+			UE_LOG(LogTemp, Warning, TEXT("Hit Jugador"));
 		}
 	}
-	UKismetSystemLibrary::DrawDebugLine(this, StartPosition, EndPosition, FLinearColor::Red, 5.0f);
 }
-
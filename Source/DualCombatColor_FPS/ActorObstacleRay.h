@@ -27,12 +27,36 @@ public:
 
 	UPROPERTY(EditDefaultsOnly)
 		TEnumAsByte<ECollisionChannel> TraceChannel;
+
+	/** Seconds between traces of this ray. 0 traces every frame. */
+	UPROPERTY(EditAnywhere)
+		float updateInterval = 0.0f;
+
+	/** Draws the ray while parkour.RayObstacle.DrawDebug is on. */
+	UPROPERTY(EditAnywhere)
+		bool bDrawDebugRay = true;
+
+	FVector GetRayStart() const;
+	FVector GetRayEnd() const;
+
+	/** Point of the beam closest to the given location. */
+	FVector GetClosestRayPoint(const FVector& location) const;
+
+	/** Applies the damage of a blocking hit found by URayObstacleSubsystem. */
+	void ApplyRayHit(const FHitResult& HitResult);
+
+	/** Turns the ray back on after a respawn. */
+	void ActivateRay();
+
+	/** Hides the ray and stops its traces. Used instead of Destroy so a respawn can bring it back. */
+	void DeactivateRay();
+
+	FORCEINLINE bool IsRayActive() const { return bRayActive; }
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
-	
-	void CheckShootRay();
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	bool bRayActive = true;
 };
@@ -2,8 +2,7 @@
 
 #include "AssetLoaderManager.h"
 #include "ParkourGameInstance.h"
-#include "Engine/StreamableManager.h"
-#include "Engine/AssetManager.h"
+#include "AssetStreamingSubsystem.h"
 
 // Sets default values
 AAssetLoaderManager::AAssetLoaderManager()
@@ -18,9 +17,27 @@ void AAssetLoaderManager::BeginPlay()
 {
 	Super::BeginPlay();
 	UParkourGameInstance* parkourGameInstance = Cast<UParkourGameInstance>(GetGameInstance());
-	parkourGameInstance->SetAssetLoaderInstance(this);
-	
+	if (parkourGameInstance != nullptr)
+	{
+		parkourGameInstance->SetAssetLoaderInstance(this);
+	}
+}
+
+void AAssetLoaderManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming != nullptr)
+	{
+		for (int32 requestId : requestIds)
+		{
+			streaming->ReleaseRequest(requestId);
+		}
+	}
+	requestIds.Empty();
+	OnAssetsLoadedDelegate.Clear();
+	Super::EndPlay(EndPlayReason);
 }
+
 void AAssetLoaderManager::OnAssetLoaded()
 {
 	OnAssetsLoadedDelegate.Broadcast();
@@ -31,16 +48,25 @@ void AAssetLoaderManager::AddAssetToLoad(TSoftObjectPtr<UObject> AssetToBeLoaded
 }
 void AAssetLoaderManager::LoadAssets(bool bAsyncLoad) 
 {
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming == nullptr)
+	{
+		return;
+	}
 	TArray<FSoftObjectPath> ItemsToStream;
-
-	FStreamableManager& Streamble = UAssetManager::GetStreamableManager();
 	for (int32 i = 0; i < AssetsToLoad.Num(); i++)
 	{
-		ItemsToStream.AddUnique(AssetsToLoad[i].ToStringReference());
+		ItemsToStream.AddUnique(AssetsToLoad[i].ToSoftObjectPath());
 	}
-	//Carga Asyncronica (Async)
-	Streamble.RequestAsyncLoad(ItemsToStream, FStreamableDelegate::CreateUObject(this, &AAssetLoaderManager::OnAssetLoaded));
-	
-	//FALTA AGREGAR CARGA Syncronica (Sync)
-}
+	// La lista se vacia para que no crezca con cada carga
+	AssetsToLoad.Reset();
 
+	const FOnAssetRequestComplete onComplete = FOnAssetRequestComplete::CreateUObject(this, &AAssetLoaderManager::OnAssetLoaded);
+	const int32 requestId = bAsyncLoad
+		? streaming->RequestAssets(ItemsToStream, onComplete, loadPriority)
+		: streaming->LoadAssetsSynchronous(ItemsToStream, onComplete);
+	if (requestId != INDEX_NONE)
+	{
+		requestIds.Add(requestId);
+	}
+}
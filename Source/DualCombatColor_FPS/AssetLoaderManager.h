@@ -7,6 +7,10 @@
 #include "AssetLoaderManager.generated.h"
 DECLARE_MULTICAST_DELEGATE(FOnAssetsLoaded);
 
+/**
+ * Level actor that gathers soft references and loads them through UAssetStreamingSubsystem.
+ * The request is released with the level.
+ */
 UCLASS()
 class DUALCOMBATCOLOR_FPS_API AAssetLoaderManager : public AActor
 {
@@ -20,9 +24,17 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY()
 		TArray<TSoftObjectPtr<UObject>> AssetsToLoad;
 
+	/** Priority of the streaming request, higher loads first. */
+	UPROPERTY(EditAnywhere)
+		int32 loadPriority = 0;
+
+	TArray<int32> requestIds;
+
 public:	
 	// Called every frame
 	//virtual void Tick(float DeltaTime) override;
@@ -33,6 +45,7 @@ public:
 
 	void AddAssetToLoad(TSoftObjectPtr<UObject> AssetToBeLoaded);
 
+	/** Requests the added assets and clears the list. OnAssetsLoadedDelegate is broadcast when they are loaded. */
 	void LoadAssets(bool bAsyncLoad = true);
 	
 	FOnAssetsLoaded OnAssetsLoadedDelegate;
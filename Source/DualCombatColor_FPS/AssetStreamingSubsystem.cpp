@@ -0,0 +1,353 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetStreamingSubsystem.h"
+#include "Engine/AssetManager.h"
+
+void UAssetStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	preLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UAssetStreamingSubsystem::OnPreLoadMap);
+}
+
+void UAssetStreamingSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(preLoadMapHandle);
+	if (tickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(tickerHandle);
+		tickerHandle.Reset();
+	}
+	for (TPair<int32, FAssetStreamingRequest>& pair : requests)
+	{
+		if (pair.Value.handle.IsValid())
+		{
+			pair.Value.handle->CancelHandle();
+		}
+	}
+	requests.Empty();
+	queuedRequests.Empty();
+	loadingRequests = 0;
+	primaryAssetCounts.Empty();
+	bundleCounts.Empty();
+	Super::Deinitialize();
+}
+
+int32 UAssetStreamingSubsystem::RequestAssets(const TArray<FSoftObjectPath>& assets, FOnAssetRequestComplete onComplete, int32 priority, bool bPersistent)
+{
+	FAssetStreamingRequest request;
+	for (const FSoftObjectPath& asset : assets)
+	{
+		if (!asset.IsNull())
+		{
+			request.assets.AddUnique(asset);
+		}
+	}
+	if (request.assets.Num() == 0)
+	{
+		onComplete.ExecuteIfBound();
+		return INDEX_NONE;
+	}
+	request.onComplete = onComplete;
+	request.priority = priority;
+	request.bPersistent = bPersistent;
+
+	const int32 requestId = nextRequestId++;
+	requests.Add(requestId, MoveTemp(request));
+	queuedRequests.Add(requestId);
+
+	// Los pedidos del mismo frame se juntan y se cargan en el proximo tick
+	if (!tickerHandle.IsValid())
+	{
+		tickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAssetStreamingSubsystem::TickFlush));
+	}
+	return requestId;
+}
+
+int32 UAssetStreamingSubsystem::RequestAsset(const FSoftObjectPath& asset, FOnAssetRequestComplete onComplete, int32 priority, bool bPersistent)
+{
+	TArray<FSoftObjectPath> assets;
+	assets.Add(asset);
+	return RequestAssets(assets, onComplete, priority, bPersistent);
+}
+
+int32 UAssetStreamingSubsystem::LoadAssetsSynchronous(const TArray<FSoftObjectPath>& assets, FOnAssetRequestComplete onComplete, bool bPersistent)
+{
+	FAssetStreamingRequest request;
+	for (const FSoftObjectPath& asset : assets)
+	{
+		if (!asset.IsNull())
+		{
+			request.assets.AddUnique(asset);
+		}
+	}
+	if (request.assets.Num() == 0)
+	{
+		onComplete.ExecuteIfBound();
+		return INDEX_NONE;
+	}
+	request.bPersistent = bPersistent;
+	request.handle = UAssetManager::GetStreamableManager().RequestSyncLoad(request.assets);
+	request.bComplete = true;
+
+	const int32 requestId = nextRequestId++;
+	requests.Add(requestId, MoveTemp(request));
+	onComplete.ExecuteIfBound();
+	return requestId;
+}
+
+int32 UAssetStreamingSubsystem::PreloadBundles(FPrimaryAssetType primaryAssetType, const TArray<FName>& bundles, FOnAssetRequestComplete onComplete, int32 priority, bool bPersistent)
+{
+	UAssetManager& assetManager = UAssetManager::Get();
+	FAssetStreamingRequest request;
+	assetManager.GetPrimaryAssetIdList(primaryAssetType, request.primaryAssets);
+	if (request.primaryAssets.Num() == 0)
+	{
+		onComplete.ExecuteIfBound();
+		return INDEX_NONE;
+	}
+	for (const FPrimaryAssetId& primaryAsset : request.primaryAssets)
+	{
+		request.assets.Add(assetManager.GetPrimaryAssetPath(primaryAsset));
+	}
+	request.bundles = bundles;
+	request.onComplete = onComplete;
+	request.priority = priority;
+	request.bPersistent = bPersistent;
+
+	// LoadPrimaryAssets reemplaza el estado de bundles, se pide la union de lo que sostienen todos los pedidos
+	const TArray<FName> heldBundles = AcquireBundles(request);
+	const TArray<FPrimaryAssetId> primaryAssets = request.primaryAssets;
+
+	const int32 requestId = nextRequestId++;
+	requests.Add(requestId, MoveTemp(request));
+
+	// El AssetManager ya carga todos los assets y bundles en un solo lote
+	TArray<int32> requestIds;
+	requestIds.Add(requestId);
+	loadingRequests++;
+	TSharedPtr<FStreamableHandle> handle = assetManager.LoadPrimaryAssets(primaryAssets, heldBundles,
+		FStreamableDelegate::CreateUObject(this, &UAssetStreamingSubsystem::OnBatchLoaded, requestIds), priority);
+	FAssetStreamingRequest* loadedRequest = requests.Find(requestId);
+	if (loadedRequest == nullptr)
+	{
+		// El callback ya libero el pedido
+		return requestId;
+	}
+	loadedRequest->handle = handle;
+	if (!handle.IsValid())
+	{
+		// Ya estaban cargados
+		OnBatchLoaded(requestIds);
+	}
+	return requestId;
+}
+
+bool UAssetStreamingSubsystem::TickFlush(float DeltaTime)
+{
+	tickerHandle.Reset();
+	FlushRequests();
+	return false;
+}
+
+void UAssetStreamingSubsystem::FlushRequests()
+{
+	if (queuedRequests.Num() == 0)
+	{
+		return;
+	}
+	// Un lote por prioridad y alcance, para poder soltar los de nivel sin tocar los persistentes
+	TMap<TPair<int32, bool>, TArray<int32>> batches;
+	for (int32 requestId : queuedRequests)
+	{
+		const FAssetStreamingRequest* request = requests.Find(requestId);
+		if (request != nullptr)
+		{
+			batches.FindOrAdd(TPair<int32, bool>(request->priority, request->bPersistent)).Add(requestId);
+		}
+	}
+	queuedRequests.Reset();
+
+	FStreamableManager& streamable = UAssetManager::GetStreamableManager();
+	for (TPair<TPair<int32, bool>, TArray<int32>>& batch : batches)
+	{
+		TArray<FSoftObjectPath> batchAssets;
+		for (int32 requestId : batch.Value)
+		{
+			for (const FSoftObjectPath& asset : requests.FindChecked(requestId).assets)
+			{
+				batchAssets.AddUnique(asset);
+			}
+		}
+
+		loadingRequests += batch.Value.Num();
+		TSharedPtr<FStreamableHandle> handle = streamable.RequestAsyncLoad(batchAssets,
+			FStreamableDelegate::CreateUObject(this, &UAssetStreamingSubsystem::OnBatchLoaded, batch.Value), batch.Key.Key);
+		if (!handle.IsValid())
+		{
+			// Ninguna ruta era valida, los pedidos se dan por terminados
+			OnBatchLoaded(batch.Value);
+			continue;
+		}
+		for (int32 requestId : batch.Value)
+		{
+			FAssetStreamingRequest* request = requests.Find(requestId);
+			if (request != nullptr)
+			{
+				request->handle = handle;
+			}
+		}
+	}
+}
+
+void UAssetStreamingSubsystem::OnBatchLoaded(TArray<int32> requestIds)
+{
+	for (int32 requestId : requestIds)
+	{
+		FAssetStreamingRequest* request = requests.Find(requestId);
+		if (request == nullptr || request->bComplete)
+		{
+			continue;
+		}
+		request->bComplete = true;
+		loadingRequests--;
+		// Se copia, el callback puede liberar el pedido y modificar el mapa
+		FOnAssetRequestComplete onComplete = request->onComplete;
+		onComplete.ExecuteIfBound();
+	}
+}
+
+void UAssetStreamingSubsystem::ReleaseRequest(int32 requestId)
+{
+	FAssetStreamingRequest request;
+	if (!requests.RemoveAndCopyValue(requestId, request))
+	{
+		return;
+	}
+	queuedRequests.Remove(requestId);
+	if (!request.bComplete && request.handle.IsValid())
+	{
+		loadingRequests--;
+	}
+	if (request.primaryAssets.Num() > 0)
+	{
+		ReleaseBundles(request);
+	}
+	// El handle se libera cuando el ultimo pedido del lote lo suelta
+}
+
+TArray<FName> UAssetStreamingSubsystem::AcquireBundles(const FAssetStreamingRequest& request)
+{
+	TArray<FName> heldBundles;
+	for (const FPrimaryAssetId& primaryAsset : request.primaryAssets)
+	{
+		primaryAssetCounts.FindOrAdd(primaryAsset)++;
+		TMap<FName, int32>& counts = bundleCounts.FindOrAdd(primaryAsset);
+		for (const FName& bundle : request.bundles)
+		{
+			counts.FindOrAdd(bundle)++;
+		}
+		for (const TPair<FName, int32>& count : counts)
+		{
+			heldBundles.AddUnique(count.Key);
+		}
+	}
+	return heldBundles;
+}
+
+void UAssetStreamingSubsystem::ReleaseBundles(const FAssetStreamingRequest& request)
+{
+	UAssetManager& assetManager = UAssetManager::Get();
+	TArray<FPrimaryAssetId> unusedAssets;
+	for (const FPrimaryAssetId& primaryAsset : request.primaryAssets)
+	{
+		int32* assetCount = primaryAssetCounts.Find(primaryAsset);
+		if (assetCount == nullptr)
+		{
+			continue;
+		}
+		if (--(*assetCount) <= 0)
+		{
+			// Ningun pedido lo sostiene, se descarga entero con todos sus bundles
+			primaryAssetCounts.Remove(primaryAsset);
+			bundleCounts.Remove(primaryAsset);
+			unusedAssets.Add(primaryAsset);
+			continue;
+		}
+
+		TMap<FName, int32>& counts = bundleCounts.FindOrAdd(primaryAsset);
+		TArray<FName> unusedBundles;
+		for (const FName& bundle : request.bundles)
+		{
+			int32* bundleCount = counts.Find(bundle);
+			if (bundleCount != nullptr && --(*bundleCount) <= 0)
+			{
+				counts.Remove(bundle);
+				unusedBundles.Add(bundle);
+			}
+		}
+		if (unusedBundles.Num() > 0)
+		{
+			TArray<FPrimaryAssetId> changedAssets;
+			changedAssets.Add(primaryAsset);
+			assetManager.ChangeBundleStateForPrimaryAssets(changedAssets, TArray<FName>(), unusedBundles);
+		}
+	}
+	if (unusedAssets.Num() > 0)
+	{
+		assetManager.UnloadPrimaryAssets(unusedAssets);
+	}
+}
+
+void UAssetStreamingSubsystem::ReleaseLevelRequests()
+{
+	TArray<int32> levelRequests;
+	for (const TPair<int32, FAssetStreamingRequest>& pair : requests)
+	{
+		if (!pair.Value.bPersistent)
+		{
+			levelRequests.Add(pair.Key);
+		}
+	}
+	for (int32 requestId : levelRequests)
+	{
+		TSharedPtr<FStreamableHandle> handle = requests.FindChecked(requestId).handle;
+		ReleaseRequest(requestId);
+		// Un lote que todavia esta cargando se cancela para no completar en el nivel nuevo
+		if (handle.IsValid() && handle->IsLoadingInProgress())
+		{
+			handle->CancelHandle();
+		}
+	}
+}
+
+bool UAssetStreamingSubsystem::IsRequestComplete(int32 requestId) const
+{
+	const FAssetStreamingRequest* request = requests.Find(requestId);
+	return request != nullptr && request->bComplete;
+}
+
+float UAssetStreamingSubsystem::GetProgress() const
+{
+	int32 totalAssets = 0;
+	float loadedAssets = 0.0f;
+	for (const TPair<int32, FAssetStreamingRequest>& pair : requests)
+	{
+		const FAssetStreamingRequest& request = pair.Value;
+		totalAssets += request.assets.Num();
+		if (request.bComplete)
+		{
+			loadedAssets += request.assets.Num();
+		}
+		else if (request.handle.IsValid())
+		{
+			loadedAssets += request.handle->GetProgress() * request.assets.Num();
+		}
+	}
+	return totalAssets > 0 ? loadedAssets / totalAssets : 1.0f;
+}
+
+void UAssetStreamingSubsystem::OnPreLoadMap(const FString& mapName)
+{
+	ReleaseLevelRequests();
+}
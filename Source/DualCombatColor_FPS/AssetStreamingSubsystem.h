@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
+#include "UObject/PrimaryAssetId.h"
+#include "AssetStreamingSubsystem.generated.h"
+
+DECLARE_DELEGATE(FOnAssetRequestComplete);
+
+struct FAssetStreamingRequest
+{
+	TArray<FSoftObjectPath> assets;
+	FOnAssetRequestComplete onComplete;
+	int32 priority = FStreamableManager::DefaultAsyncLoadPriority;
+	/** Persistent requests survive level changes, the rest are released on PreLoadMap. */
+	bool bPersistent = false;
+	bool bComplete = false;
+	/** Primary assets and bundles of a PreloadBundles request. Releasing it drops its hold on them. */
+	TArray<FPrimaryAssetId> primaryAssets;
+	TArray<FName> bundles;
+	/** Shared by every request coalesced in the same batch. */
+	TSharedPtr<FStreamableHandle> handle;
+};
+
+/**
+ * Single entry point for streaming soft referenced assets. Requests made during a frame are
+ * coalesced into one async load per priority, keep their streamable handle until they are
+ * released, and level requests are released before the next map loads so the assets of one
+ * level do not stay resident in the next.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API UAssetStreamingSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Queues the assets to be loaded with the next batch. onComplete runs once all of them are in memory.
+	 * Returns the id used to release the request, or INDEX_NONE if there was nothing to load.
+	 */
+	int32 RequestAssets(const TArray<FSoftObjectPath>& assets, FOnAssetRequestComplete onComplete, int32 priority = FStreamableManager::DefaultAsyncLoadPriority, bool bPersistent = false);
+
+	int32 RequestAsset(const FSoftObjectPath& asset, FOnAssetRequestComplete onComplete, int32 priority = FStreamableManager::DefaultAsyncLoadPriority, bool bPersistent = false);
+
+	/** Loads the assets before returning, blocking the game thread. onComplete runs before this returns. */
+	int32 LoadAssetsSynchronous(const TArray<FSoftObjectPath>& assets, FOnAssetRequestComplete onComplete, bool bPersistent = false);
+
+	/**
+	 * Loads the bundles of every primary asset of the type in one async batch. Bundle state is
+	 * reference counted: releasing the request, or leaving the level if it is not persistent,
+	 * only removes the bundles no other request holds, and unloads the primary assets once the
+	 * last request for them is released.
+	 */
+	int32 PreloadBundles(FPrimaryAssetType primaryAssetType, const TArray<FName>& bundles, FOnAssetRequestComplete onComplete, int32 priority = FStreamableManager::DefaultAsyncLoadPriority, bool bPersistent = false);
+
+	/** Starts the queued batches now instead of waiting for the next tick. */
+	void FlushRequests();
+
+	/** Drops the request. Its assets can be garbage collected once no other request holds them. */
+	void ReleaseRequest(int32 requestId);
+
+	/** Releases every non persistent request, queued or loaded. Called before a new map loads. */
+	void ReleaseLevelRequests();
+
+	bool IsRequestComplete(int32 requestId) const;
+
+	/** Loaded fraction of the unreleased requests, from 0 to 1. For loading screens. */
+	float GetProgress() const;
+
+	FORCEINLINE bool IsLoading() const { return queuedRequests.Num() > 0 || loadingRequests > 0; }
+
+private:
+	bool TickFlush(float DeltaTime);
+	void OnBatchLoaded(TArray<int32> requestIds);
+	void OnPreLoadMap(const FString& mapName);
+
+	/** Counts the request's hold on its assets and bundles. Returns every bundle held on them after it. */
+	TArray<FName> AcquireBundles(const FAssetStreamingRequest& request);
+	/** Drops the request's hold, removing the bundles and unloading the assets no request holds anymore. */
+	void ReleaseBundles(const FAssetStreamingRequest& request);
+
+	TMap<int32, FAssetStreamingRequest> requests;
+	TArray<int32> queuedRequests;
+	int32 nextRequestId = 1;
+	int32 loadingRequests = 0;
+
+	// Pedidos vivos que sostienen cada primary asset y cada uno de sus bundles
+	TMap<FPrimaryAssetId, int32> primaryAssetCounts;
+	TMap<FPrimaryAssetId, TMap<FName, int32>> bundleCounts;
+
+	FDelegateHandle tickerHandle;
+	FDelegateHandle preLoadMapHandle;
+};
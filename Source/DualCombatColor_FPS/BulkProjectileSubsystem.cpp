@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BulkProjectileSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "DualCombatColor_FPSProjectile.h"
+
+void UBulkProjectileSubsystem::Deinitialize()
+{
+	ClearProjectiles();
+	visualActor = nullptr;
+	instancedMesh = nullptr;
+	Super::Deinitialize();
+}
+
+void UBulkProjectileSubsystem::FireProjectile(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass, UStaticMesh* mesh, const FVector& location, const FRotator& rotation, bool bShooterPlayer, AActor* shooter)
+{
+	if (projectileClass == nullptr || positions.Num() >= maxBulkProjectiles)
+	{
+		return;
+	}
+	if (GetOrCreateInstancedMesh(mesh) == nullptr)
+	{
+		return;
+	}
+
+	const ADualCombatColor_FPSProjectile* defaults = projectileClass->GetDefaultObject<ADualCombatColor_FPSProjectile>();
+	const UProjectileMovementComponent* movement = defaults->GetProjectileMovement();
+	const USphereComponent* collision = defaults->GetCollisionComp();
+
+	previousPositions.Add(location);
+	positions.Add(location);
+	velocities.Add(rotation.Vector() * movement->InitialSpeed);
+	lifeTimes.Add(defaults->InitialLifeSpan > 0.0f ? defaults->InitialLifeSpan : 3.0f);
+	radii.Add(collision->GetUnscaledSphereRadius());
+	gravities.Add(GetWorld()->GetGravityZ() * movement->ProjectileGravityScale);
+	bounciness.Add(movement->bShouldBounce ? movement->Bounciness : -1.0f);
+	damages.Add(defaults->damageBullet);
+	shooterPlayer.Add(bShooterPlayer);
+	shooters.Add(shooter);
+}
+
+void UBulkProjectileSubsystem::ClearProjectiles()
+{
+	previousPositions.Reset();
+	positions.Reset();
+	velocities.Reset();
+	lifeTimes.Reset();
+	radii.Reset();
+	gravities.Reset();
+	bounciness.Reset();
+	damages.Reset();
+	shooterPlayer.Reset();
+	shooters.Reset();
+	UpdateInstances();
+}
+
+void UBulkProjectileSubsystem::Tick(float DeltaTime)
+{
+	Integrate(DeltaTime);
+	SweepAndResolveHits();
+	UpdateInstances();
+}
+
+bool UBulkProjectileSubsystem::IsTickable() const
+{
+	return !IsTemplate() && positions.Num() > 0;
+}
+
+TStatId UBulkProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBulkProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void UBulkProjectileSubsystem::Integrate(float DeltaTime)
+{
+	const int32 count = positions.Num();
+
+	// Una sola pasada lineal sobre arrays contiguos, sin llamadas virtuales ni componentes
+	FMemory::Memcpy(previousPositions.GetData(), positions.GetData(), count * sizeof(FVector));
+	FVector* RESTRICT position = positions.GetData();
+	FVector* RESTRICT velocity = velocities.GetData();
+	float* RESTRICT lifeTime = lifeTimes.GetData();
+	const float* RESTRICT gravity = gravities.GetData();
+	for (int32 i = 0; i < count; i++)
+	{
+		velocity[i].Z += gravity[i] * DeltaTime;
+		position[i] += velocity[i] * DeltaTime;
+		lifeTime[i] -= DeltaTime;
+	}
+}
+
+void UBulkProjectileSubsystem::SweepAndResolveHits()
+{
+	UWorld* world = GetWorld();
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(BulkProjectileSweep), false);
+	static const FName projectileProfile(TEXT("Projectile"));
+
+	// Recorrido de atras hacia adelante: RemoveProjectile mueve el ultimo elemento al indice borrado
+	for (int32 i = positions.Num() - 1; i >= 0; i--)
+	{
+		if (lifeTimes[i] <= 0.0f)
+		{
+			RemoveProjectile(i);
+			continue;
+		}
+
+		queryParams.ClearIgnoredActors();
+		if (shooters[i].IsValid())
+		{
+			queryParams.AddIgnoredActor(shooters[i].Get());
+		}
+
+		FHitResult hit;
+		if (!world->SweepSingleByProfile(hit, previousPositions[i], positions[i], FQuat::Identity, projectileProfile, FCollisionShape::MakeSphere(radii[i]), queryParams))
+		{
+			continue;
+		}
+
+		if (ADualCombatColor_FPSProjectile::ApplyProjectileHit(world, nullptr, hit.GetActor(), hit.GetComponent(), shooterPlayer[i], damages[i], velocities[i], hit.Location, hit.Item))
+		{
+			RemoveProjectile(i);
+		}
+		else if (bounciness[i] >= 0.0f)
+		{
+			// Rebote equivalente al de UProjectileMovementComponent con bShouldBounce
+			const FVector normalVelocity = hit.ImpactNormal * FVector::DotProduct(velocities[i], hit.ImpactNormal);
+			velocities[i] = (velocities[i] - normalVelocity) - normalVelocity * bounciness[i];
+			positions[i] = hit.Location + hit.ImpactNormal * 0.1f;
+		}
+		else
+		{
+			RemoveProjectile(i);
+		}
+	}
+}
+
+void UBulkProjectileSubsystem::RemoveProjectile(int32 index)
+{
+	previousPositions.RemoveAtSwap(index, 1, false);
+	positions.RemoveAtSwap(index, 1, false);
+	velocities.RemoveAtSwap(index, 1, false);
+	lifeTimes.RemoveAtSwap(index, 1, false);
+	radii.RemoveAtSwap(index, 1, false);
+	gravities.RemoveAtSwap(index, 1, false);
+	bounciness.RemoveAtSwap(index, 1, false);
+	damages.RemoveAtSwap(index, 1, false);
+	shooterPlayer.RemoveAtSwap(index, 1, false);
+	shooters.RemoveAtSwap(index, 1, false);
+}
+
+void UBulkProjectileSubsystem::UpdateInstances()
+{
+	if (instancedMesh == nullptr)
+	{
+		return;
+	}
+	const int32 count = positions.Num();
+	instanceTransforms.SetNum(count, false);
+	for (int32 i = 0; i < count; i++)
+	{
+		instanceTransforms[i] = FTransform(velocities[i].Rotation(), positions[i]);
+	}
+
+	// Las instancias siguen el mismo orden que los arrays, solo se agregan o quitan al final
+	int32 instanceCount = instancedMesh->GetInstanceCount();
+	while (instanceCount > count)
+	{
+		instancedMesh->RemoveInstance(--instanceCount);
+	}
+	while (instanceCount < count)
+	{
+		instancedMesh->AddInstanceWorldSpace(instanceTransforms[instanceCount++]);
+	}
+	if (count > 0)
+	{
+		instancedMesh->BatchUpdateInstancesTransforms(0, instanceTransforms, true, true, true);
+	}
+}
+
+UInstancedStaticMeshComponent* UBulkProjectileSubsystem::GetOrCreateInstancedMesh(UStaticMesh* mesh)
+{
+	if (instancedMesh != nullptr)
+	{
+		return instancedMesh;
+	}
+	if (mesh == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BulkProjectileSubsystem: no hay mesh para las balas"));
+		return nullptr;
+	}
+
+	FActorSpawnParameters spawnParams;
+	spawnParams.Name = TEXT("BulkProjectileVisuals");
+	spawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	visualActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, spawnParams);
+	if (visualActor == nullptr)
+	{
+		return nullptr;
+	}
+
+	instancedMesh = NewObject<UInstancedStaticMeshComponent>(visualActor, TEXT("BulkProjectileInstances"));
+	instancedMesh->SetStaticMesh(mesh);
+	instancedMesh->SetMobility(EComponentMobility::Movable);
+	instancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	instancedMesh->SetCastShadow(false);
+	visualActor->SetRootComponent(instancedMesh);
+	instancedMesh->RegisterComponent();
+	return instancedMesh;
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "BulkProjectileSubsystem.generated.h"
+
+class ADualCombatColor_FPSProjectile;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * "Bulk" projectile mode: simulates every bullet in packed arrays with one pass per frame
+ * and draws them all with a single instanced mesh, instead of one actor per bullet.
+ * Hits use the same rules as ADualCombatColor_FPSProjectile::OnHit.
+ */
+UCLASS(config=Game)
+class DUALCOMBATCOLOR_FPS_API UBulkProjectileSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Bullets above this count are not fired. */
+	UPROPERTY(Config)
+		int32 maxBulkProjectiles = 2048;
+
+	/**
+	 * Fires a bullet using the speed, damage, lifetime, radius and gravity of the projectile class defaults.
+	 * The mesh is only used the first time to create the instanced mesh.
+	 */
+	void FireProjectile(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass, UStaticMesh* mesh, const FVector& location, const FRotator& rotation, bool bShooterPlayer, AActor* shooter);
+
+	/** Removes every bullet in flight. */
+	void ClearProjectiles();
+
+	FORCEINLINE int32 GetProjectileCount() const { return positions.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject
+
+private:
+	void Integrate(float DeltaTime);
+	void SweepAndResolveHits();
+	void RemoveProjectile(int32 index);
+	void UpdateInstances();
+	UInstancedStaticMeshComponent* GetOrCreateInstancedMesh(UStaticMesh* mesh);
+
+	// Datos de las balas en arrays empaquetados (structure of arrays)
+	TArray<FVector> previousPositions;
+	TArray<FVector> positions;
+	TArray<FVector> velocities;
+	TArray<float> lifeTimes;
+	TArray<float> radii;
+	TArray<float> gravities;
+	TArray<float> bounciness;
+	TArray<int32> damages;
+	TArray<bool> shooterPlayer;
+	TArray<TWeakObjectPtr<AActor>> shooters;
+
+	TArray<FTransform> instanceTransforms;
+
+	UPROPERTY()
+		AActor* visualActor = nullptr;
+
+	UPROPERTY()
+		UInstancedStaticMeshComponent* instancedMesh = nullptr;
+};
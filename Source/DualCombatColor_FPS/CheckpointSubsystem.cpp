@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CheckpointSubsystem.h"
+#include "PlatformPawn.h"
+#include "ActorObstacleRay.h"
+
+void UCheckpointSubsystem::Deinitialize()
+{
+	treadPlatforms.Empty();
+	disabledRays.Empty();
+	Super::Deinitialize();
+}
+
+void UCheckpointSubsystem::SetCheckpoint(const FTransform& inRespawnTransform, int32 score, APlatformPawn* platform)
+{
+	respawnTransform = inRespawnTransform;
+	checkpointPlatform = platform;
+	platformOffset = (platform != nullptr) ? inRespawnTransform.GetLocation() - platform->GetActorLocation() : FVector::ZeroVector;
+	checkpointScore = score;
+	bHasCheckpoint = true;
+	treadPlatforms.Reset();
+	disabledRays.Reset();
+}
+
+FTransform UCheckpointSubsystem::GetRespawnTransform() const
+{
+	if (checkpointPlatform.IsValid())
+	{
+		// La plataforma puede haberse movido desde que se piso
+		return FTransform(respawnTransform.GetRotation(), checkpointPlatform->GetActorLocation() + platformOffset);
+	}
+	return respawnTransform;
+}
+
+void UCheckpointSubsystem::RecordTreadPlatform(APlatformPawn* platform)
+{
+	treadPlatforms.Add(platform);
+}
+
+void UCheckpointSubsystem::RecordDisabledRay(AActorObstacleRay* ray)
+{
+	disabledRays.Add(ray);
+}
+
+void UCheckpointSubsystem::ResetToCheckpoint()
+{
+	for (const TWeakObjectPtr<APlatformPawn>& platform : treadPlatforms)
+	{
+		if (platform.IsValid())
+		{
+			platform->bIsTread = false;
+		}
+	}
+	for (const TWeakObjectPtr<AActorObstacleRay>& ray : disabledRays)
+	{
+		if (ray.IsValid())
+		{
+			ray->ActivateRay();
+		}
+	}
+	treadPlatforms.Reset();
+	disabledRays.Reset();
+}
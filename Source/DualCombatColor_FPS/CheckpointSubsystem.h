@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CheckpointSubsystem.generated.h"
+
+class APlatformPawn;
+class AActorObstacleRay;
+
+/**
+ * Remembers the last checkpoint the player reached and what changed in the level since then:
+ * platforms marked as tread and rays turned off by hitting the player. On death the player is
+ * put back at the checkpoint and only those actors are reset, instead of reloading the map.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API UCheckpointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * Saves the respawn point and the score at that moment, and forgets the changes made before it.
+	 * With a platform the respawn point follows it, so a moving checkpoint platform is found where it is now.
+	 */
+	void SetCheckpoint(const FTransform& respawnTransform, int32 score, APlatformPawn* platform = nullptr);
+
+	FORCEINLINE bool HasCheckpoint() const { return bHasCheckpoint; }
+	/** Respawn point over the checkpoint platform, or the saved transform if there is no platform or it was destroyed. */
+	FTransform GetRespawnTransform() const;
+	FORCEINLINE int32 GetCheckpointScore() const { return checkpointScore; }
+
+	/** A platform became tread after the last checkpoint. */
+	void RecordTreadPlatform(APlatformPawn* platform);
+
+	/** A ray was turned off after the last checkpoint. */
+	void RecordDisabledRay(AActorObstacleRay* ray);
+
+	/** Undoes the recorded changes: platforms can be tread again and rays are back on. */
+	void ResetToCheckpoint();
+
+private:
+	FTransform respawnTransform;
+	TWeakObjectPtr<APlatformPawn> checkpointPlatform;
+	/** Respawn location relative to checkpointPlatform. */
+	FVector platformOffset = FVector::ZeroVector;
+	int32 checkpointScore = 0;
+	bool bHasCheckpoint = false;
+
+	TArray<TWeakObjectPtr<APlatformPawn>> treadPlatforms;
+	TArray<TWeakObjectPtr<AActorObstacleRay>> disabledRays;
+};
@@ -7,21 +7,36 @@
 #include "Components/TextBlock.h"
 #include "kismet/GameplayStatics.h"
 #include "Components/Widget.h"
+#include "LevelSnapshotSubsystem.h"
 
 void UDefeatMenuWidget::NativeOnInitialized()
 {
 	Super::NativeOnInitialized();
 
-	CanvasDefeatMenu->SetVisibility(ESlateVisibility::Hidden);
+	if (textYouScore != nullptr)
+	{
+		scoreLabel = textYouScore->Text;
+	}
+}
+
+void UDefeatMenuWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// El widget vive en la GameInstance y se vuelve a construir en cada mapa, los botones se enlazan aca porque NativeDestruct los suelta
+	if (CanvasDefeatMenu != nullptr)
+	{
+		CanvasDefeatMenu->SetVisibility(ESlateVisibility::Collapsed);
+	}
 
 	if (ButtonRetry != nullptr)
 	{
-		ButtonRetry->OnClicked.AddDynamic(this, &ThisClass::OnClickButtonRetry);
+		ButtonRetry->OnClicked.AddUniqueDynamic(this, &ThisClass::OnClickButtonRetry);
 		//UE_LOG(LogTemp, Warning, TEXT("Boton seteado"));
 	}
 	if (ButtonExit != nullptr)
 	{
-		ButtonExit->OnClicked.AddDynamic(this, &ThisClass::OnClikedButtonExit);
+		ButtonExit->OnClicked.AddUniqueDynamic(this, &ThisClass::OnClikedButtonExit);
 		//UE_LOG(LogTemp, Warning, TEXT("Boton seteado"));
 	}
 }
@@ -39,7 +54,7 @@ void UDefeatMenuWidget::SetScoreText(int _score)
 {
 	if (textYouScore != nullptr)
 	{
-		FString text = FString::Printf(TEXT("%s %i"), *textYouScore->Text.ToString(), _score);
+		FString text = FString::Printf(TEXT("%s %i"), *scoreLabel.ToString(), _score);
 		
 		//FString text1 = textYouScore->Text.ToString();
 		//FString text2 = FString::Printf(TEXT("%i"), _score);
@@ -52,6 +67,13 @@ void UDefeatMenuWidget::SetScoreText(int _score)
 
 void UDefeatMenuWidget::OnClickButtonRetry()
 {
+	// Se vuelve al estado del inicio del nivel sin recargar el mapa
+	ULevelSnapshotSubsystem* levelSnapshot = GetWorld()->GetSubsystem<ULevelSnapshotSubsystem>();
+	if (levelSnapshot != nullptr && levelSnapshot->RestoreSnapshot())
+	{
+		CanvasDefeatMenu->SetVisibility(ESlateVisibility::Collapsed);
+		return;
+	}
 	UGameplayStatics::OpenLevel(this, FName(*GetWorld()->GetName()), false);
 }
 
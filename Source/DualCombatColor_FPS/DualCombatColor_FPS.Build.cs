@@ -8,6 +8,14 @@ public class DualCombatColor_FPS : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "Slate", "SlateCore", "UMG" });
+
+		// The game does not ship VR. Set to true to build the motion controller rig of the character.
+		bool bWithVRRig = false;
+		if (bWithVRRig)
+		{
+			PublicDependencyModuleNames.Add("HeadMountedDisplay");
+		}
+		PublicDefinitions.Add("WITH_VR_RIG=" + (bWithVRRig ? "1" : "0"));
 	}
 }
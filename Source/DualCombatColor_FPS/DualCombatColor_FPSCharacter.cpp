@@ -2,16 +2,15 @@
 
 #include "DualCombatColor_FPSCharacter.h"
 #include "DualCombatColor_FPSProjectile.h"
+#include "ProjectilePoolSubsystem.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
 #include "GameFramework/InputSettings.h"
-#include "HeadMountedDisplayFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "Blueprint/UserWidget.h"
 #include "MainMenuWidget.h"
-#include "MotionControllerComponent.h"
 #include "PauseMenuWidget.h"
 #include "VictoryMenuWidget.h"
 #include "DefeatMenuWidget.h"
@@ -20,7 +19,16 @@
 #include "UI_PlayerWidget.h"
 #include "VictoryPointActor.h"
 #include "ParkourGameInstance.h"
+#include "HealthComponent.h"
+#include "CheckpointSubsystem.h"
+#include "LevelSnapshotSubsystem.h"
+#include "UILayerSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#if WITH_VR_RIG
+#include "HeadMountedDisplayFunctionLibrary.h"
+#include "MotionControllerComponent.h"
 #include "XRMotionControllerBase.h" // for FXRMotionControllerBase::RightHandSourceId
+#endif
 
 DEFINE_LOG_CATEGORY_STATIC(LogFPChar, Warning, All);
 
@@ -68,26 +76,12 @@ ADualCombatColor_FPSCharacter::ADualCombatColor_FPSCharacter()
 	// Note: The ProjectileClass and the skeletal mesh/anim blueprints for Mesh1P, FP_Gun, and VR_Gun 
 	// are set in the derived blueprint asset named MyCharacter to avoid direct content references in C++.
 
-	// Create VR Controllers.
-	R_MotionController = CreateDefaultSubobject<UMotionControllerComponent>(TEXT("R_MotionController"));
-	R_MotionController->MotionSource = FXRMotionControllerBase::RightHandSourceId;
-	R_MotionController->SetupAttachment(RootComponent);
-	L_MotionController = CreateDefaultSubobject<UMotionControllerComponent>(TEXT("L_MotionController"));
-	L_MotionController->SetupAttachment(RootComponent);
+	// Los controles de VR y su arma se crean en BeginPlay solo si se usan (ver CreateVRRig)
 
-	// Create a gun and attach it to the right-hand VR controller.
-	// Create a gun mesh component
-	VR_Gun = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("VR_Gun"));
-	VR_Gun->SetOnlyOwnerSee(true);			// only the owning player will see this mesh
-	VR_Gun->bCastDynamicShadow = false;
-	VR_Gun->CastShadow = false;
-	VR_Gun->SetupAttachment(R_MotionController);
-	VR_Gun->SetRelativeRotation(FRotator(0.0f, -90.0f, 0.0f));
+	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComponent"));
 
-	VR_MuzzleLocation = CreateDefaultSubobject<USceneComponent>(TEXT("VR_MuzzleLocation"));
-	VR_MuzzleLocation->SetupAttachment(VR_Gun);
-	VR_MuzzleLocation->SetRelativeLocation(FVector(0.000004, 53.999992, 10.000000));
-	VR_MuzzleLocation->SetRelativeRotation(FRotator(0.0f, 90.0f, 0.0f));		// Counteract the rotation of the VR gun model.
+	// La vida la maneja HealthComponent con eventos, el personaje no necesita Tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Uncomment the following line to turn motion controllers on by default:
 	//bUsingMotionControllers = true;
@@ -103,6 +97,8 @@ void ADualCombatColor_FPSCharacter::BeginPlay()
 	//staticMesh->SetMaterial(,);
 
 	GetCapsuleComponent()->OnComponentBeginOverlap.AddDynamic(this, &ADualCombatColor_FPSCharacter::OnComponentBeginOverlap);
+	HealthComponent->OnHealthChanged.AddDynamic(this, &ADualCombatColor_FPSCharacter::OnHealthChanged);
+	HealthComponent->OnDeath.AddDynamic(this, &ADualCombatColor_FPSCharacter::Die);
 	//Attach gun mesh component to Skeleton, doing it here because the skeleton is not yet created in the constructor
 	FP_Gun->AttachToComponent(Mesh1P, FAttachmentTransformRules(EAttachmentRule::SnapToTarget, true), TEXT("GripPoint"));
 	
@@ -125,83 +121,129 @@ void ADualCombatColor_FPSCharacter::BeginPlay()
 	}
 
 	// Show or hide the two versions of the gun based on whether or not we're using motion controllers.
-	if (bUsingMotionControllers)
+	if (bUsingMotionControllers && !CreateVRRig())
 	{
-		VR_Gun->SetHiddenInGame(false, true);
-		Mesh1P->SetHiddenInGame(true, true);
-	}
-	else
-	{
-		VR_Gun->SetHiddenInGame(true, true);
-		Mesh1P->SetHiddenInGame(false, true);
+		UE_LOG(LogTemp, Warning, TEXT("bUsingMotionControllers sin WITH_VR_RIG, se usa el arma en primera persona"));
+		bUsingMotionControllers = false;
 	}
+	Mesh1P->SetHiddenInGame(bUsingMotionControllers, true);
 
 	UParkourGameInstance* parkourGameInstance = Cast<UParkourGameInstance>(GetGameInstance());
 	if (parkourGameInstance != nullptr) 
 	{
 		FdataPlayer.numberCurrentLevel = parkourGameInstance->currentData.currentLevel;
 		FdataPlayer.score = parkourGameInstance->currentData.currentScore;
-		FdataPlayer.life = 100;
+		FdataPlayer.life = HealthComponent->GetLife();
 	}
 	else 
 	{
 		UE_LOG(LogTemp, Warning, TEXT("parkourGameInstance nulo"));
 	}
 	isPaused = false;
-	//Created Menus
-	CreatedPauseMenu();
-	CreatedVictoryMenu();
-	CreatedDefeatMenu();
+
+	// El inicio del nivel es el primer checkpoint
+	UCheckpointSubsystem* checkpoints = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+	if (checkpoints != nullptr)
+	{
+		checkpoints->SetCheckpoint(GetActorTransform(), FdataPlayer.score);
+	}
+
+	// El estado inicial del nivel se guarda para que Retry no tenga que recargar el mapa
+	ULevelSnapshotSubsystem* levelSnapshot = GetWorld()->GetSubsystem<ULevelSnapshotSubsystem>();
+	if (levelSnapshot != nullptr)
+	{
+		levelSnapshot->RequestCapture();
+	}
+
+	UProjectilePoolSubsystem* projectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	if (projectilePool != nullptr)
+	{
+		projectilePool->Prewarm(ProjectileClass, ProjectilePoolSize);
+	}
+	// Los menus se crean la primera vez que se abren, el HUD se vuelve a mostrar en cada nivel
+	const double uiStartTime = FPlatformTime::Seconds();
 	CreatedUI_Player();
 	UI_PlayerWidget->SetScoreText(FdataPlayer.score);
 	UI_PlayerWidget->SetCurrentLifeText(FdataPlayer.life);
 	UI_PlayerWidget->SetCurrentLevelText(FdataPlayer.numberCurrentLevel);
+	UUILayerSubsystem* uiLayer = GetGameInstance()->GetSubsystem<UUILayerSubsystem>();
+	if (uiLayer != nullptr)
+	{
+		uiLayer->RecordLevelStart((float)((FPlatformTime::Seconds() - uiStartTime) * 1000.0));
+	}
 	//---------------
 }
-void ADualCombatColor_FPSCharacter::Tick(float DeltaSeconds)
-{
 
-	CheckDie();
-	if(!PauseMenuWidget)
-		UE_LOG(LogTemp, Warning, TEXT("pause bad"));
-
-	if (!VictoryMenuWidget)
-		UE_LOG(LogTemp, Warning, TEXT("victory bad"));
+EGameplayRole ADualCombatColor_FPSCharacter::GetGameplayRoles() const
+{
+	return EGameplayRole::Player | IGameplayRoleActor::GetRolesFromTags(this);
+}
 
-	if (!DefeatMenuWidget)
-		UE_LOG(LogTemp, Warning, TEXT("defeat bad"));
+void ADualCombatColor_FPSCharacter::Die()
+{
+	UCheckpointSubsystem* checkpoints = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+	if (bRespawnAtCheckpoint && checkpoints != nullptr && checkpoints->HasCheckpoint())
+	{
+		RespawnAtCheckpoint();
+		return;
+	}
+	//Si te moris se reinicia el nivel
+	UGameplayStatics::OpenLevel(GetWorld(), FName(*GetWorld()->GetName()), false);
+}
 
-	bool MenuSuccefullyLoaded = (!DefeatMenuWidget && !VictoryMenuWidget) && !PauseMenuWidget;
+void ADualCombatColor_FPSCharacter::RespawnAtCheckpoint()
+{
+	UCheckpointSubsystem* checkpoints = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+	checkpoints->ResetToCheckpoint();
 
-	if (!MenuSuccefullyLoaded) 
+	const FTransform respawnTransform = checkpoints->GetRespawnTransform();
+	GetCharacterMovement()->StopMovementImmediately();
+	SetActorLocationAndRotation(respawnTransform.GetLocation(), respawnTransform.Rotator(), false, nullptr, ETeleportType::ResetPhysics);
+	if (Controller != nullptr)
 	{
-		if (playerController)
-			CheckCursorVisible();
-		else
-			UE_LOG(LogTemp, Warning, TEXT("Player nulo"));
+		Controller->SetControlRotation(respawnTransform.Rotator());
 	}
-	else 
+
+	FdataPlayer.score = checkpoints->GetCheckpointScore();
+	if (UI_PlayerWidget != nullptr)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Menu alguno es nulo"));
+		UI_PlayerWidget->SetScoreText(FdataPlayer.score);
 	}
-	
+	HealthComponent->ResetHealth();
 }
-void ADualCombatColor_FPSCharacter::Die()
+void ADualCombatColor_FPSCharacter::OnLevelRestored(const FRotator& controlRotation)
 {
-	//Si te moris se reinicia el nivel
-	UGameplayStatics::OpenLevel(GetWorld(), FName(*GetWorld()->GetName()), false);
+	GetCharacterMovement()->StopMovementImmediately();
+	if (Controller != nullptr)
+	{
+		Controller->SetControlRotation(controlRotation);
+	}
+	HealthComponent->SetLife(FdataPlayer.life);
+	if (UI_PlayerWidget != nullptr)
+	{
+		UI_PlayerWidget->SetScoreText(FdataPlayer.score);
+		UI_PlayerWidget->SetCurrentLifeText(FdataPlayer.life);
+	}
+	if (isPaused)
+	{
+		PauseGame();
+	}
 }
-void ADualCombatColor_FPSCharacter::CheckDie()
+
+void ADualCombatColor_FPSCharacter::OnHealthChanged(int32 newLife, int32 delta)
 {
-	if (FdataPlayer.life <= 0)
+	// Llega una vez por frame aunque el jugador haya recibido varios golpes
+	FdataPlayer.life = newLife;
+	if (UI_PlayerWidget != nullptr)
 	{
-		Die();
+		UI_PlayerWidget->SetCurrentLifeText(FdataPlayer.life);
 	}
 }
 
 void ADualCombatColor_FPSCharacter::OnComponentBeginOverlap(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromeSweep, const FHitResult& SweepResult)
 {
-	if (OtherActor->ActorHasTag("Plattform"))
+	const EGameplayRole otherRoles = IGameplayRoleActor::GetActorRoles(OtherActor);
+	if (EnumHasAnyFlags(otherRoles, EGameplayRole::Platform))
 	{
 		APlatformPawn* platform = Cast<APlatformPawn>(OtherActor);
 		if (platform != nullptr) 
@@ -211,10 +253,24 @@ void ADualCombatColor_FPSCharacter::OnComponentBeginOverlap(UPrimitiveComponent*
 				platform->bIsTread = true;
 				FdataPlayer.score = FdataPlayer.score + addScoreForPlatformTread;
 				UI_PlayerWidget->SetScoreText(FdataPlayer.score);
+
+				UCheckpointSubsystem* checkpoints = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+				if (checkpoints != nullptr)
+				{
+					if (platform->bIsCheckpoint)
+					{
+						const FVector respawnLocation = platform->GetActorLocation() + FVector(0.0f, 0.0f, checkpointRespawnHeight);
+						checkpoints->SetCheckpoint(FTransform(GetActorRotation(), respawnLocation), FdataPlayer.score, platform);
+					}
+					else
+					{
+						checkpoints->RecordTreadPlatform(platform);
+					}
+				}
 			}
 		}
 	}
-	if(OtherActor->ActorHasTag("VictoryPoint"))
+	if (EnumHasAnyFlags(otherRoles, EGameplayRole::VictoryPoint))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("NextLevel Collision"));
 		AVictoryPointActor* victoryPoint = Cast<AVictoryPointActor>(OtherActor);
@@ -310,42 +366,43 @@ void ADualCombatColor_FPSCharacter::CheckCursorVisible()
 
 void ADualCombatColor_FPSCharacter::CreatedUI_Player()
 {
-	if (UI_PlayerWidget_Class != nullptr)
+	UUILayerSubsystem* uiLayer = GetGameInstance()->GetSubsystem<UUILayerSubsystem>();
+	if (uiLayer != nullptr)
 	{
-		UI_PlayerWidget = CreateWidget<UUI_PlayerWidget>(Cast<APlayerController>(GetOwner()), UI_PlayerWidget_Class, FName("UI_PlayerWidget"));
-		UI_PlayerWidget->AddToViewport();
+		UI_PlayerWidget = uiLayer->ShowWidget<UUI_PlayerWidget>(UI_PlayerWidget_Class);
 	}
 }
 
 void ADualCombatColor_FPSCharacter::CreatedPauseMenu()
 {
-	if (PauseMenuWidget_Class != nullptr)
+	UUILayerSubsystem* uiLayer = GetGameInstance()->GetSubsystem<UUILayerSubsystem>();
+	if (uiLayer != nullptr)
 	{
-		PauseMenuWidget = CreateWidget<UPauseMenuWidget>(Cast<APlayerController>(GetOwner()), PauseMenuWidget_Class, FName("PauseMenuWidget"));
-		PauseMenuWidget->AddToViewport();
+		PauseMenuWidget = uiLayer->ShowWidget<UPauseMenuWidget>(PauseMenuWidget_Class);
 	}
 }
 
 void ADualCombatColor_FPSCharacter::CreatedVictoryMenu()
 {
-	if (VictoryMenuWidget_Class != nullptr)
+	UUILayerSubsystem* uiLayer = GetGameInstance()->GetSubsystem<UUILayerSubsystem>();
+	if (uiLayer != nullptr)
 	{
-		VictoryMenuWidget = CreateWidget<UVictoryMenuWidget>(Cast<APlayerController>(GetOwner()), VictoryMenuWidget_Class, FName("VictoryMenuWidget"));
-		VictoryMenuWidget->AddToViewport();
+		VictoryMenuWidget = uiLayer->ShowWidget<UVictoryMenuWidget>(VictoryMenuWidget_Class);
 	}
 }
 
 void ADualCombatColor_FPSCharacter::CreatedDefeatMenu()
 {
-	if (DefeatMenuWidget_Class != nullptr)
+	UUILayerSubsystem* uiLayer = GetGameInstance()->GetSubsystem<UUILayerSubsystem>();
+	if (uiLayer != nullptr)
 	{
-		DefeatMenuWidget = CreateWidget<UDefeatMenuWidget>(Cast<APlayerController>(GetOwner()), DefeatMenuWidget_Class, FName("DefeatMenuWidget"));
-		DefeatMenuWidget->AddToViewport();
+		DefeatMenuWidget = uiLayer->ShowWidget<UDefeatMenuWidget>(DefeatMenuWidget_Class);
 	}
 }
 
 void ADualCombatColor_FPSCharacter::OpenVictoryMenu()
 {
+	CreatedVictoryMenu();
 	if (VictoryMenuWidget != nullptr)
 	{
 		VictoryMenuWidget->ActivateMe();
@@ -360,6 +417,7 @@ void ADualCombatColor_FPSCharacter::OpenVictoryMenu()
 
 void ADualCombatColor_FPSCharacter::OpenDefeatMenu()
 {
+	CreatedDefeatMenu();
 	if (DefeatMenuWidget != nullptr)
 	{
 		DefeatMenuWidget->ActivateMe();
@@ -375,6 +433,7 @@ void ADualCombatColor_FPSCharacter::OpenDefeatMenu()
 void ADualCombatColor_FPSCharacter::OpenPauseMenu()
 {
 	UE_LOG(LogTemp, Warning, TEXT("P"));
+	CreatedPauseMenu();
 	if (PauseMenuWidget != nullptr) 
 	{
 		PauseMenuWidget->ActivateMe();
@@ -393,13 +452,14 @@ void ADualCombatColor_FPSCharacter::OnFire()
 	if (ProjectileClass != NULL)
 	{
 		UWorld* const World = GetWorld();
-		if (World != NULL)
+		UProjectilePoolSubsystem* const ProjectilePool = (World != NULL) ? World->GetSubsystem<UProjectilePoolSubsystem>() : NULL;
+		if (ProjectilePool != NULL)
 		{
-			if (bUsingMotionControllers)
+			if (bUsingMotionControllers && VR_MuzzleLocation != nullptr)
 			{
 				const FRotator SpawnRotation = VR_MuzzleLocation->GetComponentRotation();
 				const FVector SpawnLocation = VR_MuzzleLocation->GetComponentLocation();
-				World->SpawnActor<ADualCombatColor_FPSProjectile>(ProjectileClass, SpawnLocation, SpawnRotation);
+				ProjectilePool->AcquireProjectile(ProjectileClass, SpawnLocation, SpawnRotation);
 			}
 			else
 			{
@@ -407,13 +467,12 @@ void ADualCombatColor_FPSCharacter::OnFire()
 				// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
 				const FVector SpawnLocation = ((FP_MuzzleLocation != nullptr) ? FP_MuzzleLocation->GetComponentLocation() : GetActorLocation()) + SpawnRotation.RotateVector(GunOffset);
 
-				//Set Spawn Collision Handling Override
-				FActorSpawnParameters ActorSpawnParams;
-				ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-				// spawn the projectile at the muzzle
-				ADualCombatColor_FPSProjectile* projectile = World->SpawnActor<ADualCombatColor_FPSProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
-				projectile->bShooterPlayer = true;
+				// take a projectile from the pool and launch it from the muzzle
+				ADualCombatColor_FPSProjectile* projectile = ProjectilePool->AcquireProjectile(ProjectileClass, SpawnLocation, SpawnRotation);
+				if (projectile != nullptr)
+				{
+					projectile->bShooterPlayer = true;
+				}
 			}
 		}
 	}
@@ -438,7 +497,49 @@ void ADualCombatColor_FPSCharacter::OnFire()
 
 void ADualCombatColor_FPSCharacter::OnResetVR()
 {
+#if WITH_VR_RIG
 	UHeadMountedDisplayFunctionLibrary::ResetOrientationAndPosition();
+#endif
+}
+
+bool ADualCombatColor_FPSCharacter::CreateVRRig()
+{
+#if WITH_VR_RIG
+	if (VR_Gun != nullptr)
+	{
+		return true;
+	}
+	// Create VR Controllers.
+	UMotionControllerComponent* rightController = NewObject<UMotionControllerComponent>(this, TEXT("R_MotionController"));
+	rightController->MotionSource = FXRMotionControllerBase::RightHandSourceId;
+	rightController->SetupAttachment(RootComponent);
+	rightController->RegisterComponent();
+	R_MotionController = rightController;
+
+	UMotionControllerComponent* leftController = NewObject<UMotionControllerComponent>(this, TEXT("L_MotionController"));
+	leftController->SetupAttachment(RootComponent);
+	leftController->RegisterComponent();
+	L_MotionController = leftController;
+
+	// Create a gun and attach it to the right-hand VR controller.
+	VR_Gun = NewObject<USkeletalMeshComponent>(this, TEXT("VR_Gun"));
+	VR_Gun->SetOnlyOwnerSee(true);			// only the owning player will see this mesh
+	VR_Gun->bCastDynamicShadow = false;
+	VR_Gun->CastShadow = false;
+	VR_Gun->SetSkeletalMesh(VRGunMesh != nullptr ? VRGunMesh : FP_Gun->SkeletalMesh);
+	VR_Gun->SetupAttachment(R_MotionController);
+	VR_Gun->SetRelativeRotation(FRotator(0.0f, -90.0f, 0.0f));
+	VR_Gun->RegisterComponent();
+
+	VR_MuzzleLocation = NewObject<USceneComponent>(this, TEXT("VR_MuzzleLocation"));
+	VR_MuzzleLocation->SetupAttachment(VR_Gun);
+	VR_MuzzleLocation->SetRelativeLocation(FVector(0.000004, 53.999992, 10.000000));
+	VR_MuzzleLocation->SetRelativeRotation(FRotator(0.0f, 90.0f, 0.0f));		// Counteract the rotation of the VR gun model.
+	VR_MuzzleLocation->RegisterComponent();
+	return true;
+#else
+	return false;
+#endif
 }
 
 void ADualCombatColor_FPSCharacter::BeginTouch(const ETouchIndex::Type FingerIndex, const FVector Location)
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameplayRoleActor.h"
 #include "DualCombatColor_FPSCharacter.generated.h"
 
 class UInputComponent;
@@ -11,6 +12,7 @@ class UPauseMenuWidget;
 class UVictoryMenuWidget;
 class UDefeatMenuWidget;
 class UUI_PlayerWidget;
+class UHealthComponent;
 
 USTRUCT()
 struct FDataPlayer
@@ -26,7 +28,7 @@ public:
 };
 
 UCLASS(config=Game)
-class ADualCombatColor_FPSCharacter : public ACharacter
+class ADualCombatColor_FPSCharacter : public ACharacter, public IGameplayRoleActor
 {
 	GENERATED_BODY()
 
@@ -42,29 +44,35 @@ class ADualCombatColor_FPSCharacter : public ACharacter
 	UPROPERTY(VisibleDefaultsOnly, Category = Mesh)
 	class USceneComponent* FP_MuzzleLocation;
 
-	/** Gun mesh: VR view (attached to the VR controller directly, no arm, just the actual gun) */
-	UPROPERTY(VisibleDefaultsOnly, Category = Mesh)
+	/** Gun mesh: VR view (attached to the VR controller directly, no arm, just the actual gun). Created in BeginPlay only with motion controllers. */
+	UPROPERTY(Transient)
 	class USkeletalMeshComponent* VR_Gun;
 
 	/** Location on VR gun mesh where projectiles should spawn. */
-	UPROPERTY(VisibleDefaultsOnly, Category = Mesh)
+	UPROPERTY(Transient)
 	class USceneComponent* VR_MuzzleLocation;
 
 	/** First person camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	class UCameraComponent* FirstPersonCameraComponent;
 
-	/** Motion controller (right hand) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
-	class UMotionControllerComponent* R_MotionController;
+	/** Motion controller (right hand). A UMotionControllerComponent when the VR rig was built, otherwise null. */
+	UPROPERTY(Transient, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class USceneComponent* R_MotionController;
 
-	/** Motion controller (left hand) */
+	/** Motion controller (left hand). A UMotionControllerComponent when the VR rig was built, otherwise null. */
+	UPROPERTY(Transient, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class USceneComponent* L_MotionController;
+
+	/** Life of the player. Projectiles and rays damage it through ApplyDamage. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
-	class UMotionControllerComponent* L_MotionController;
+	UHealthComponent* HealthComponent;
 
 public:
 	ADualCombatColor_FPSCharacter();
 
+	virtual EGameplayRole GetGameplayRoles() const override;
+
 	UPROPERTY(EditAnywhere, Category = "UI HUD")
 		TSubclassOf<UUI_PlayerWidget> UI_PlayerWidget_Class;
 	UPROPERTY()
@@ -90,14 +98,24 @@ public:
 
 	UPROPERTY()
 		FDataPlayer FdataPlayer;
+
+	/** Called by ULevelSnapshotSubsystem after FdataPlayer and the transform were restored. Resyncs health, UI and pause. */
+	void OnLevelRestored(const FRotator& controlRotation);
 protected:
 
 	virtual void BeginPlay();
-	virtual void Tick(float DeltaSeconds) override;
 	//Game Play Functions and Variables
 	//int score;
 	UPROPERTY(EditAnywhere)
 		int addScoreForPlatformTread = 10;
+
+	/** On death respawn at the last checkpoint. When off, or with no checkpoint, the level is reloaded. */
+	UPROPERTY(EditAnywhere)
+		bool bRespawnAtCheckpoint = true;
+
+	/** Height over a checkpoint platform where the player respawns. */
+	UPROPERTY(EditAnywhere)
+		float checkpointRespawnHeight = 150.0f;
 	bool isPaused;
 	void PauseGame();
 	
@@ -111,6 +129,7 @@ protected:
 			int32 OtherBodyIndex, bool bFromeSweep, const FHitResult& SweepResult);
 
 	// Menu Functions
+	/** The Created functions show the widget through UUILayerSubsystem, which builds it on first use and keeps it across levels. */
 	void CreatedUI_Player();
 
 	void CreatedPauseMenu();
@@ -128,9 +147,14 @@ protected:
 	void CheckCursorVisible();
 	//-------------------
 
-	void CheckDie();
+	UFUNCTION()
+		void OnHealthChanged(int32 newLife, int32 delta);
+
+	UFUNCTION()
+		void Die();
 
-	void Die();
+	/** Puts the player back at the last checkpoint with full life and the checkpoint score. */
+	void RespawnAtCheckpoint();
 public:
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Camera)
@@ -148,6 +172,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Projectile)
 	TSubclassOf<class ADualCombatColor_FPSProjectile> ProjectileClass;
 
+	/** Projectiles of ProjectileClass created when the level starts */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	int32 ProjectilePoolSize = 16;
+
 	/** Sound to play each time we fire */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
 	class USoundBase* FireSound;
@@ -156,10 +184,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	class UAnimMontage* FireAnimation;
 
-	/** Whether to use motion controller location for aiming. */
+	/** Whether to use motion controller location for aiming. Ignored in builds without WITH_VR_RIG. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	uint32 bUsingMotionControllers : 1;
 
+	/** Mesh of the VR gun. When empty the mesh of FP_Gun is used. */
+	UPROPERTY(EditDefaultsOnly, Category = Mesh)
+	class USkeletalMesh* VRGunMesh;
+
 protected:
 	/** Fires a projectile. */
 	void OnFire();
@@ -167,6 +199,9 @@ protected:
 	/** Resets HMD orientation and position in VR. */
 	void OnResetVR();
 
+	/** Creates the motion controllers and the VR gun. Returns false in builds without WITH_VR_RIG. */
+	bool CreateVRRig();
+
 	/** Handles moving forward/backward */
 	void MoveForward(float Val);
 
@@ -216,6 +251,8 @@ public:
 	FORCEINLINE class USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
 	/** Returns FirstPersonCameraComponent subobject **/
 	FORCEINLINE class UCameraComponent* GetFirstPersonCameraComponent() const { return FirstPersonCameraComponent; }
+	/** Returns HealthComponent subobject **/
+	FORCEINLINE UHealthComponent* GetHealthComponent() const { return HealthComponent; }
 
 };
 
@@ -4,8 +4,11 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "DualCombatColor_FPSCharacter.h"
-#include "UI_PlayerWidget.h"
+#include "HealthComponent.h"
+#include "ProjectilePoolSubsystem.h"
+#include "GameplayRoleActor.h"
+#include "InstancedTargetField.h"
+#include "TimerManager.h"
 
 ADualCombatColor_FPSProjectile::ADualCombatColor_FPSProjectile() 
 {
@@ -34,31 +37,110 @@ ADualCombatColor_FPSProjectile::ADualCombatColor_FPSProjectile()
 	InitialLifeSpan = 3.0f;
 }
 
+void ADualCombatColor_FPSProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+	if (ownerPool != nullptr)
+	{
+		// El pool maneja el tiempo de vida, AActor no debe destruirlo
+		SetLifeSpan(0.0f);
+	}
+}
+
+void ADualCombatColor_FPSProjectile::SetPooled(UProjectilePoolSubsystem* pool)
+{
+	ownerPool = pool;
+	SetLifeSpan(0.0f);
+}
+
+void ADualCombatColor_FPSProjectile::ActivateProjectile(const FVector& location, const FRotator& rotation)
+{
+	SetActorLocationAndRotation(location, rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	ProjectileMovement->SetUpdatedComponent(CollisionComp);
+	ProjectileMovement->Velocity = rotation.Vector() * ProjectileMovement->InitialSpeed;
+	ProjectileMovement->UpdateComponentVelocity();
+	ProjectileMovement->Activate(true);
+
+	// Un proyectil reciclado vuelve con los valores por defecto de su clase
+	bShooterPlayer = GetClass()->GetDefaultObject<ADualCombatColor_FPSProjectile>()->bShooterPlayer;
+	bProjectileActive = true;
+	if (InitialLifeSpan > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(lifeTimerHandle, this, &ADualCombatColor_FPSProjectile::ReleaseProjectile, InitialLifeSpan, false);
+	}
+}
+
+void ADualCombatColor_FPSProjectile::DeactivateProjectile()
+{
+	bProjectileActive = false;
+	GetWorldTimerManager().ClearTimer(lifeTimerHandle);
+
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+void ADualCombatColor_FPSProjectile::ReleaseProjectile()
+{
+	if (ownerPool != nullptr)
+	{
+		ownerPool->ReleaseProjectile(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
 void ADualCombatColor_FPSProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	if (!bProjectileActive)
+	{
+		return;
+	}
+	if (ApplyProjectileHit(GetWorld(), this, OtherActor, OtherComp, bShooterPlayer, damageBullet, GetVelocity(), GetActorLocation(), Hit.Item))
+	{
+		ReleaseProjectile();
+	}
+}
+
+bool ADualCombatColor_FPSProjectile::ApplyProjectileHit(UWorld* world, const AActor* projectile, AActor* OtherActor, UPrimitiveComponent* OtherComp, bool bShooterPlayer, int damage, const FVector& velocity, const FVector& location, int32 hitItem)
 {
 	// Only add impulse and destroy projectile if we hit a physics
-	if (OtherActor != NULL) 
+	if (OtherActor != NULL && !bShooterPlayer) 
 	{
-		if (OtherActor->ActorHasTag("Pared") && !bShooterPlayer) 
+		const EGameplayRole otherRoles = IGameplayRoleActor::GetActorRoles(OtherActor);
+		if (EnumHasAnyFlags(otherRoles, EGameplayRole::Wall)) 
 		{
-			Destroy();
+			return true;
 		}
-		if (OtherActor->ActorHasTag("Player") && !bShooterPlayer) 
+		if (EnumHasAnyFlags(otherRoles, EGameplayRole::Player)) 
 		{
-			ADualCombatColor_FPSCharacter* Player = Cast<ADualCombatColor_FPSCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
-			if (Player != nullptr)
+			UHealthComponent* health = OtherActor->FindComponentByClass<UHealthComponent>();
+			if (health != nullptr)
 			{
-				Player->FdataPlayer.life = Player->FdataPlayer.life - damageBullet;
-				Player->UI_PlayerWidget->SetCurrentLifeText(Player->FdataPlayer.life);
+				health->ApplyDamage(damage, const_cast<AActor*>(projectile));
 
-				Destroy();
+				return true;
 			}
 		}
 	}
-	if ((OtherActor != NULL) && (OtherActor != this) && (OtherComp != NULL) && OtherComp->IsSimulatingPhysics())
+	// Los objetivos instanciados se convierten en actor con fisica antes de recibir el impulso
+	AInstancedTargetField* targetField = Cast<AInstancedTargetField>(OtherActor);
+	if (targetField != nullptr && targetField->OnInstanceHit(OtherComp, hitItem, velocity * 100.0f, location))
 	{
-		OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
+		return true;
+	}
+	if ((OtherActor != NULL) && (OtherActor != projectile) && (OtherComp != NULL) && OtherComp->IsSimulatingPhysics())
+	{
+		OtherComp->AddImpulseAtLocation(velocity * 100.0f, location);
 
-		Destroy();
+		return true;
 	}
-}
\ No newline at end of file
+	return false;
+}
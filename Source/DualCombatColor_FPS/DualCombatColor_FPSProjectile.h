@@ -9,6 +9,7 @@
 class ADualCombatColor_FPSCharacter;
 class UGameplayStatics;
 class UUI_PlayerWidget;
+class UProjectilePoolSubsystem;
 
 UCLASS(config=Game)
 class ADualCombatColor_FPSProjectile : public AActor
@@ -34,9 +35,41 @@ public:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/**
+	 * Applies the gameplay effect of a projectile touching OtherActor: player damage, walls and physics impulse.
+	 * Shared by OnHit and the bulk projectile simulation. hitItem is the instance index for instanced targets.
+	 * @returns true if the projectile must be removed.
+	 */
+	static bool ApplyProjectileHit(UWorld* world, const AActor* projectile, AActor* OtherActor, UPrimitiveComponent* OtherComp, bool bShooterPlayer, int damage, const FVector& velocity, const FVector& location, int32 hitItem = INDEX_NONE);
+
+	/** Marks this projectile as owned by a pool. Its lifetime is then handled with a timer instead of InitialLifeSpan. */
+	void SetPooled(UProjectilePoolSubsystem* pool);
+
+	/** Places, shows and launches the projectile. */
+	void ActivateProjectile(const FVector& location, const FRotator& rotation);
+
+	/** Stops, hides and disables collision on the projectile. */
+	void DeactivateProjectile();
+
+	/** Returns the projectile to its pool, or destroys it if it was not pooled. */
+	void ReleaseProjectile();
+
+	FORCEINLINE bool IsProjectileActive() const { return bProjectileActive; }
+
 	/** Returns CollisionComp subobject **/
 	FORCEINLINE class USphereComponent* GetCollisionComp() const { return CollisionComp; }
 	/** Returns ProjectileMovement subobject **/
 	FORCEINLINE class UProjectileMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	UPROPERTY()
+		UProjectilePoolSubsystem* ownerPool = nullptr;
+
+	bool bProjectileActive = true;
+
+	FTimerHandle lifeTimerHandle;
 };
 
@@ -5,6 +5,11 @@
 #include "GameFramework/Actor.h" 
 #include "Engine/World.h"
 #include "PawnObjectDestructibleTarget.h"
+#include "HAL/PlatformTime.h"
+#include "EngineUtils.h"
+#include "GameplayRoleActor.h"
+#include "TargetPlacementEngine.h"
+#include "InstancedTargetField.h"
 
 ADualCombatColor_GameMode::ADualCombatColor_GameMode()
 {
@@ -14,18 +19,41 @@ ADualCombatColor_GameMode::ADualCombatColor_GameMode()
 void ADualCombatColor_GameMode::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+	if (bSpawningRound)
+	{
+		SpawnObjectsBudgeted();
+	}
 }
 
 void ADualCombatColor_GameMode::BeginPlay()
 {
 	Super::BeginPlay();
+	if (placementSeed == 0)
+	{
+		placementSeed = FMath::Rand();
+	}
+	CacheExclusionZones();
 	StartNextRound();
 }
+void ADualCombatColor_GameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		timingWheel->ClearTimer(roundTimerHandle);
+		timingWheel->ClearCohort(roundCohort);
+	}
+	Super::EndPlay(EndPlayReason);
+}
 void ADualCombatColor_GameMode::StartGame()
 {
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		roundCohort = timingWheel->CreateCohort();
+	}
+	// El timer de la ronda arranca en FinishRoundSpawn, cuando todos los objetivos ya estan en el mapa
 	SpawnObject();
-	FTimerHandle UnsedHandle;
-	GetWorldTimerManager().SetTimer(UnsedHandle, this, &ADualCombatColor_GameMode::ResultRound, timeRound, false);
 }
 /*void ADualCombatColor_GameMode::DestroyObjects()
 {
@@ -42,6 +70,18 @@ void ADualCombatColor_GameMode::StartGame()
 void ADualCombatColor_GameMode::ResultRound()
 {
 	//DestroyObjects();
+	// Vence de una vez los timers de vida que queden de la ronda
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		timingWheel->ExpireCohort(roundCohort);
+	}
+	roundCohort = INDEX_NONE;
+	ReleaseRoundTargets();
+	if (targetField != nullptr)
+	{
+		targetField->ClearTargets();
+	}
 
 	//Checkea el resultado de la ronda sumando un punto al jugador correspondiente.
 	//Checkea si el puntaje del jugador (rondas ganadas) es igual a la cantidad de rondas nesesarias para ganar la partida.
@@ -62,70 +102,283 @@ void ADualCombatColor_GameMode::ResetPositionPlayer()
 void ADualCombatColor_GameMode::StartNextRound()
 {
 	ResetPositionPlayer();
-	FTimerHandle UnsedHandle;
-	GetWorldTimerManager().SetTimer(UnsedHandle, this, &ADualCombatColor_GameMode::StartGame, startDelayRound, false);
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		roundTimerHandle = timingWheel->SetTimer(this, &ADualCombatColor_GameMode::StartGame, startDelayRound, false);
+	}
 }
 void ADualCombatColor_GameMode::SpawnObject()
 {
-	UWorld* world = GetWorld();
-	FRotator spawnRotator;
-	FVector spawnPosition;
-	int i = 0;
-	int countTeamBlueGenerated = 0;
-	int countTeamRedGenerated = 0;
-	bool GeneratedRedy = false;
-	while (!GeneratedRedy)
+	roundTargets.Reset();
+	targetsPerTeam = FMath::CeilToInt(countObjectsForRound);
+	countTeamBlueGenerated = 0;
+	countTeamRedGenerated = 0;
+	failedBlueSpawns = 0;
+	failedRedSpawns = 0;
+	bSpawnBlueNext = true;
+	bSpawningRound = true;
+
+	// Un intento por objetivo mas los reintentos de cada equipo, todos sin superposiciones
+	roundTransforms.Reset();
+	nextRoundTransform = 0;
+	if (bInstancedTargets)
 	{
-		APawnObjectDestructibleTarget* PawnObjectDestructibleTarget;
+		SpawnInstancedTargets();
+		return;
+	}
+	GenerateRoundTransforms(2 * targetsPerTeam + 2 * maxSpawnRetries, roundTransforms);
+
+	// El primer lote sale en el mismo frame, el resto en los siguientes Ticks
+	SpawnObjectsBudgeted();
+}
+
+void ADualCombatColor_GameMode::SpawnObjectsBudgeted()
+{
+	const double startTime = FPlatformTime::Seconds();
+	const double budgetSeconds = maxSpawnMillisecondsPerFrame / 1000.0;
+	const int32 spawnLimit = FMath::Max(maxSpawnsPerFrame, 1);
+	int32 spawnsThisFrame = 0;
 
-		if (countTeamBlueGenerated < countObjectsForRound) 
+	// Siempre se intenta al menos uno por frame, si no la ronda nunca termina de prepararse
+	while (spawnsThisFrame < spawnLimit && (spawnsThisFrame == 0 || FPlatformTime::Seconds() - startTime < budgetSeconds))
+	{
+		const bool bBlueDone = countTeamBlueGenerated >= targetsPerTeam || failedBlueSpawns > maxSpawnRetries;
+		const bool bRedDone = countTeamRedGenerated >= targetsPerTeam || failedRedSpawns > maxSpawnRetries;
+		if (bBlueDone && bRedDone)
 		{
-			spawnRotator = GetRandomRotator();
-			spawnPosition = GetRandomPosition();
-			PawnObjectDestructibleTarget = world->SpawnActor<APawnObjectDestructibleTarget>(cuboAzul, spawnPosition, spawnRotator);
+			FinishRoundSpawn();
+			return;
+		}
 
-			if (PawnObjectDestructibleTarget != nullptr)
+		// Se alternan los equipos para que ninguno tenga ventaja si la ronda se corta por presupuesto
+		const bool bSpawnBlue = bRedDone || (!bBlueDone && bSpawnBlueNext);
+		bSpawnBlueNext = !bSpawnBlue;
+		if (bSpawnBlue)
+		{
+			if (SpawnTarget(cuboAzul))
 			{
-				PawnObjectDestructibleTarget->bDestroyForTime = true;
-				PawnObjectDestructibleTarget->timeLife = timeRound - 0.2;
-				PawnObjectDestructibleTarget->StartTimeLife();
 				countTeamBlueGenerated++;
 			}
+			else if (++failedBlueSpawns > maxSpawnRetries)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpawnObject: el equipo azul supero %d reintentos, se generaron %d de %d"), maxSpawnRetries, countTeamBlueGenerated, targetsPerTeam);
+			}
 		}
-
-		if (countTeamRedGenerated < countObjectsForRound)
+		else
 		{
-			spawnRotator = GetRandomRotator();
-			spawnPosition = GetRandomPosition();
-			PawnObjectDestructibleTarget = world->SpawnActor<APawnObjectDestructibleTarget>(cuboRojo, spawnPosition, spawnRotator);
-
-			if (PawnObjectDestructibleTarget != nullptr)
+			if (SpawnTarget(cuboRojo))
 			{
-				PawnObjectDestructibleTarget->bDestroyForTime = true;
-				PawnObjectDestructibleTarget->timeLife = timeRound - 0.2;
-				PawnObjectDestructibleTarget->StartTimeLife();
 				countTeamRedGenerated++;
 			}
+			else if (++failedRedSpawns > maxSpawnRetries)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpawnObject: el equipo rojo supero %d reintentos, se generaron %d de %d"), maxSpawnRetries, countTeamRedGenerated, targetsPerTeam);
+			}
 		}
+		spawnsThisFrame++;
+	}
+}
 
-		GeneratedRedy = (countTeamBlueGenerated >= countObjectsForRound && countTeamRedGenerated >= countObjectsForRound);
+bool ADualCombatColor_GameMode::SpawnTarget(TSubclassOf<APawnObjectDestructibleTarget> targetClass)
+{
+	const FTransform spawnTransform = roundTransforms.IsValidIndex(nextRoundTransform) ? roundTransforms[nextRoundTransform++] : FTransform(GetRandomRotator(), GetRandomPosition());
+	APawnObjectDestructibleTarget* PawnObjectDestructibleTarget = AcquireTarget(targetClass, spawnTransform.GetLocation(), spawnTransform.Rotator());
+	if (PawnObjectDestructibleTarget == nullptr)
+	{
+		return false;
 	}
+	PawnObjectDestructibleTarget->bDestroyForTime = true;
+	PawnObjectDestructibleTarget->timeLife = timeRound - 0.2;
+	roundTargets.Add(PawnObjectDestructibleTarget);
+	return true;
+}
 
-	//UE_LOG(LogTemp, Warning, TEXT("FLACO SE SPAWNEO TU TORUS"));
+void ADualCombatColor_GameMode::FinishRoundSpawn()
+{
+	bSpawningRound = false;
 
-	/*UWorld* world = GetWorld();
+	// La vida de los objetivos y la ronda arrancan juntas, sin importar cuantos frames llevo generarlos
+	for (APawnObjectDestructibleTarget* target : roundTargets)
+	{
+		if (target != nullptr && target->IsTargetActive())
+		{
+			target->StartTimeLife(roundCohort);
+		}
+	}
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		roundTimerHandle = timingWheel->SetTimer(this, &ADualCombatColor_GameMode::ResultRound, timeRound, false);
+	}
 
-	const FRotator SpawnRotation = FRotator(.0f, .0f, .0f);
-	const FVector SpawnLocation = FVector(5.0f, 5.0f, 50.0f);
-	world->SpawnActor<AActor>(RedCube, SpawnLocation, SpawnRotation);
-	UE_LOG(LogTemp, Warning, TEXT("FLACO SE SPAWNEO TU TORUS"));*/
+	const int32 instancedTargets = (bInstancedTargets && targetField != nullptr) ? targetField->GetInstancedTargetCount() : 0;
+	OnRoundReady.Broadcast(roundTargets.Num() + instancedTargets);
+}
 
+APawnObjectDestructibleTarget* ADualCombatColor_GameMode::AcquireTarget(TSubclassOf<APawnObjectDestructibleTarget> targetClass, const FVector& position, const FRotator& rotation)
+{
+	TArray<APawnObjectDestructibleTarget*>& freeTargets = (targetClass == cuboAzul) ? freeBlueTargets : freeRedTargets;
+	while (freeTargets.Num() > 0)
+	{
+		APawnObjectDestructibleTarget* target = freeTargets.Pop(false);
+		if (target != nullptr && !target->IsPendingKill())
+		{
+			target->ActivateTarget(position, rotation);
+			return target;
+		}
+	}
+
+	APawnObjectDestructibleTarget* target = GetWorld()->SpawnActor<APawnObjectDestructibleTarget>(targetClass, position, rotation);
+	if (target != nullptr)
+	{
+		target->OnTargetReleased.BindUObject(this, &ADualCombatColor_GameMode::OnTargetReleased);
+	}
+	return target;
 }
+
+void ADualCombatColor_GameMode::OnTargetReleased(APawnObjectDestructibleTarget* target)
+{
+	if (target->GetClass() == cuboAzul)
+	{
+		freeBlueTargets.Add(target);
+	}
+	else
+	{
+		freeRedTargets.Add(target);
+	}
+}
+
+void ADualCombatColor_GameMode::ReleaseRoundTargets()
+{
+	for (APawnObjectDestructibleTarget* target : roundTargets)
+	{
+		if (target != nullptr && target->IsTargetActive())
+		{
+			target->DestroyTarget();
+		}
+	}
+	roundTargets.Reset();
+}
+
+void ADualCombatColor_GameMode::GenerateRoundTransforms(int32 count, TArray<FTransform>& outTransforms)
+{
+	// Cada ronda tiene su propia semilla derivada, asi una partida con la misma semilla se repite igual
+	placementStream.Initialize(HashCombine(GetTypeHash(placementSeed), GetTypeHash(roundIndex++)));
+
+	const FBox2D area(FVector2D(minCoord_X, minCoord_Y), FVector2D(maxCoord_X, maxCoord_Y));
+	FTargetPlacementEngine placement(area, minTargetSeparation, placementStream.GetCurrentSeed());
+	for (const FBox2D& wallBox : wallExclusionBoxes)
+	{
+		placement.AddExclusionBox(wallBox);
+	}
+	if (bHasPlayerStart)
+	{
+		placement.AddExclusionCircle(playerStartLocation, playerStartExclusionRadius);
+	}
+
+	TArray<FVector2D> positions;
+	const int32 placed = placement.GeneratePositions(count, positions);
+	if (placed < count)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GenerateRoundTransforms: solo entran %d de %d objetivos separados por %f, el resto va en posiciones al azar"), placed, count, minTargetSeparation);
+	}
+
+	outTransforms.Reserve(outTransforms.Num() + count);
+	for (const FVector2D& position : positions)
+	{
+		outTransforms.Add(FTransform(GetRandomRotator(), FVector(position, coord_Z)));
+	}
+	for (int32 i = placed; i < count; i++)
+	{
+		outTransforms.Add(FTransform(GetRandomRotator(), GetRandomPosition()));
+	}
+}
+
+void ADualCombatColor_GameMode::CacheExclusionZones()
+{
+	wallExclusionBoxes.Reset();
+	for (TActorIterator<AActor> it(GetWorld()); it; ++it)
+	{
+		if (EnumHasAnyFlags(IGameplayRoleActor::GetActorRoles(*it), EGameplayRole::Wall))
+		{
+			const FBox bounds = it->GetComponentsBoundingBox().ExpandBy(wallExclusionMargin);
+			wallExclusionBoxes.Add(FBox2D(FVector2D(bounds.Min), FVector2D(bounds.Max)));
+		}
+	}
+
+	AActor* playerStart = FindPlayerStart(GetWorld()->GetFirstPlayerController());
+	bHasPlayerStart = playerStart != nullptr;
+	if (bHasPlayerStart)
+	{
+		playerStartLocation = FVector2D(playerStart->GetActorLocation());
+	}
+}
+
+void ADualCombatColor_GameMode::SpawnInstancedTargets()
+{
+	if (targetField == nullptr)
+	{
+		FActorSpawnParameters spawnParams;
+		spawnParams.Owner = this;
+		targetField = GetWorld()->SpawnActor<AInstancedTargetField>(AInstancedTargetField::StaticClass(), FTransform::Identity, spawnParams);
+		if (targetField == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpawnInstancedTargets: no se pudo crear el campo de objetivos instanciados"));
+			FinishRoundSpawn();
+			return;
+		}
+		targetField->SetGameMode(this);
+		targetField->SetTargetMesh(instancedTargetMesh);
+	}
+
+	// Sin actores que crear no hace falta repartir la ronda en varios frames
+	GenerateRoundTransforms(2 * targetsPerTeam, roundTransforms);
+	TArray<FTransform> blueTransforms;
+	TArray<FTransform> redTransforms;
+	blueTransforms.Reserve(targetsPerTeam);
+	redTransforms.Reserve(targetsPerTeam);
+	for (int32 i = 0; i < roundTransforms.Num(); i++)
+	{
+		(i % 2 == 0 ? blueTransforms : redTransforms).Add(roundTransforms[i]);
+	}
+	targetField->SetTargets(blueTransforms, redTransforms);
+	countTeamBlueGenerated = blueTransforms.Num();
+	countTeamRedGenerated = redTransforms.Num();
+	FinishRoundSpawn();
+}
+
+APawnObjectDestructibleTarget* ADualCombatColor_GameMode::PromoteInstancedTarget(bool bBlueTeam, const FTransform& transform)
+{
+	APawnObjectDestructibleTarget* target = AcquireTarget(bBlueTeam ? cuboAzul : cuboRojo, transform.GetLocation(), transform.Rotator());
+	if (target == nullptr)
+	{
+		return nullptr;
+	}
+	target->bDestroyForTime = true;
+	target->timeLife = timeRound - 0.2;
+	roundTargets.Add(target);
+	if (!bSpawningRound && roundCohort != INDEX_NONE)
+	{
+		target->StartTimeLife(roundCohort);
+	}
+	return target;
+}
+
+float ADualCombatColor_GameMode::GetSpawnProgress() const
+{
+	if (!bSpawningRound || targetsPerTeam <= 0)
+	{
+		return 1.0f;
+	}
+	return (float)(countTeamBlueGenerated + countTeamRedGenerated) / (float)(2 * targetsPerTeam);
+}
+
 FVector ADualCombatColor_GameMode::GetRandomPosition()
 {
-	return FVector(FMath::RandRange(minCoord_X, maxCoord_X), FMath::RandRange(minCoord_Y, maxCoord_Y), coord_Z);
+	return FVector(placementStream.FRandRange(minCoord_X, maxCoord_X), placementStream.FRandRange(minCoord_Y, maxCoord_Y), coord_Z);
 }
 FRotator ADualCombatColor_GameMode::GetRandomRotator()
 {
-	return FRotator(FMath::RandRange(minRotation_X, maxRotation_X), FMath::RandRange(minRotation_Y, maxRotation_Y), FMath::RandRange(minRotation_Z, maxRotation_Z));
+	return FRotator(placementStream.FRandRange(minRotation_X, maxRotation_X), placementStream.FRandRange(minRotation_Y, maxRotation_Y), placementStream.FRandRange(minRotation_Z, maxRotation_Z));
 }
@@ -4,12 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameMode.h"
+#include "GameplayTimingWheelSubsystem.h"
 #include "DualCombatColor_GameMode.generated.h"
 
 /**
  * 
  */
 class APawnObjectDestructibleTarget;
+class AInstancedTargetField;
+class UStaticMesh;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoundReady, int32, spawnedTargets);
 
 UCLASS()
 class DUALCOMBATCOLOR_FPS_API ADualCombatColor_GameMode : public AGameMode
@@ -20,6 +25,7 @@ public:
 	ADualCombatColor_GameMode();
 	virtual void Tick(float DeltaTime) override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 		TSubclassOf<APawnObjectDestructibleTarget> cuboRojo;
@@ -83,12 +89,92 @@ public:
 
 	UPROPERTY(EditAnywhere)
 		float timeRound;
+
+	/** Maximum targets spawned in one frame while a round is being prepared. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn", meta = (ClampMin = "1"))
+		int32 maxSpawnsPerFrame = 16;
+
+	/** Time budget per frame for spawning round targets, in milliseconds. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		float maxSpawnMillisecondsPerFrame = 2.0f;
+
+	/** Failed spawns allowed per team before the team is given up for the round. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		int32 maxSpawnRetries = 10;
+
+	/** Minimum distance between two targets of the same round. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		float minTargetSeparation = 150.0f;
+
+	/** Targets are not placed closer than this to the player start. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		float playerStartExclusionRadius = 300.0f;
+
+	/** Extra space kept free around walls. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		float wallExclusionMargin = 50.0f;
+
+	/** Seed of the target placement. 0 picks a different seed every match. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		int32 placementSeed = 0;
+
+	/**
+	 * Draws the round targets as instances of one mesh per team and only spawns a
+	 * target actor when an instance is hit. Meant for rounds with thousands of targets.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn")
+		bool bInstancedTargets = false;
+
+	/** Mesh of the instanced targets. Its material reads the team and hit flash from per-instance custom data. */
+	UPROPERTY(EditAnywhere, Category = "Round Spawn", meta = (EditCondition = "bInstancedTargets"))
+		UStaticMesh* instancedTargetMesh;
+
+	/** Called when every target of the round has been spawned and the round timer starts. */
+	UPROPERTY(BlueprintAssignable)
+		FOnRoundReady OnRoundReady;
+
+	/** Fraction of the current round's targets already spawned (1 when no round is being spawned). */
+	UFUNCTION(BlueprintPure)
+		float GetSpawnProgress() const;
 	
 	//template<APawn*>
 	//void SpawnObject(TSubclassOf<APawn> object, FVector &position, FRotator &rotation);
 
+	/** Starts spawning the round's targets over the next frames. */
 	void SpawnObject();
 
+	/** Spawns round targets until the frame budget runs out. */
+	void SpawnObjectsBudgeted();
+
+	/** Spawns one target of the team. Returns false if the spawn failed. */
+	bool SpawnTarget(TSubclassOf<APawnObjectDestructibleTarget> targetClass);
+
+	void FinishRoundSpawn();
+
+	/** Takes a pooled target of the class or spawns a new one. */
+	APawnObjectDestructibleTarget* AcquireTarget(TSubclassOf<APawnObjectDestructibleTarget> targetClass, const FVector& position, const FRotator& rotation);
+
+	/** Called by pooled targets when they are destroyed by time or by the player. */
+	void OnTargetReleased(APawnObjectDestructibleTarget* target);
+
+	/** Returns every target of the round that is still active to its pool. */
+	void ReleaseRoundTargets();
+
+	/** Places every target of the round as instances in one go. */
+	void SpawnInstancedTargets();
+
+	/** Replaces a hit instance with a full target of its team. */
+	APawnObjectDestructibleTarget* PromoteInstancedTarget(bool bBlueTeam, const FTransform& transform);
+
+	/**
+	 * Places count targets without overlaps in one call, away from the player start and the walls.
+	 * If the area is too small for all of them the rest fall back to uniform positions.
+	 */
+	void GenerateRoundTransforms(int32 count, TArray<FTransform>& outTransforms);
+
+	/** Caches the areas where targets can not be placed. Walls do not move so this runs once. */
+	void CacheExclusionZones();
+
 	FVector GetRandomPosition();
 
 	FRotator GetRandomRotator();
@@ -101,6 +187,42 @@ public:
 
 	void StartNextRound();
 
+	FGameplayTimerHandle roundTimerHandle;
+
+	/** Timing wheel cohort of the timers started by the current round's targets. */
+	int32 roundCohort = INDEX_NONE;
+
+	UPROPERTY()
+		TArray<APawnObjectDestructibleTarget*> roundTargets;
+
+	// Posiciones de la ronda calculadas de una vez en SpawnObject y consumidas por SpawnTarget
+	TArray<FTransform> roundTransforms;
+	int32 nextRoundTransform = 0;
+
+	FRandomStream placementStream;
+	int32 roundIndex = 0;
+	TArray<FBox2D> wallExclusionBoxes;
+	FVector2D playerStartLocation = FVector2D::ZeroVector;
+	bool bHasPlayerStart = false;
+
+	UPROPERTY()
+		AInstancedTargetField* targetField;
+
+	// Objetivos desactivados que se reutilizan en la siguiente ronda, uno por color
+	UPROPERTY()
+		TArray<APawnObjectDestructibleTarget*> freeRedTargets;
+
+	UPROPERTY()
+		TArray<APawnObjectDestructibleTarget*> freeBlueTargets;
+
+	bool bSpawningRound = false;
+	bool bSpawnBlueNext = true;
+	int32 targetsPerTeam = 0;
+	int32 countTeamBlueGenerated = 0;
+	int32 countTeamRedGenerated = 0;
+	int32 failedBlueSpawns = 0;
+	int32 failedRedSpawns = 0;
+
 	//void DestroyObjects();
 
 };
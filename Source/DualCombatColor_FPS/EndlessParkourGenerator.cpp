@@ -0,0 +1,309 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EndlessParkourGenerator.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "PlatformPawn.h"
+#include "PlatformRegistrySubsystem.h"
+
+float FEndlessJumpSettings::GetReach(float heightDelta) const
+{
+	// z(t) = v t - g t^2 / 2, se busca el t en que el salto baja a heightDelta
+	const float discriminant = jumpZVelocity * jumpZVelocity - 2.0f * gravity * heightDelta;
+	if (discriminant < 0.0f || gravity <= 0.0f)
+	{
+		return 0.0f;
+	}
+	const float airTime = (jumpZVelocity + FMath::Sqrt(discriminant)) / gravity;
+	return runSpeed * airTime * safety;
+}
+
+AEndlessParkourGenerator::AEndlessParkourGenerator()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void AEndlessParkourGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+	if (seed == 0)
+	{
+		seed = FMath::Rand();
+	}
+	nextChunkStart = GetActorTransform();
+	nextChunkStart.SetScale3D(FVector::OneVector);
+}
+
+bool AEndlessParkourGenerator::GatherSettings()
+{
+	const ACharacter* player = UGameplayStatics::GetPlayerCharacter(this, 0);
+	if (player == nullptr || player->GetCharacterMovement() == nullptr || platformClass == nullptr)
+	{
+		return false;
+	}
+	const UCharacterMovementComponent* movement = player->GetCharacterMovement();
+	chunkSettings.seed = seed;
+	chunkSettings.platformsPerChunk = FMath::Max(platformsPerChunk, 1);
+	chunkSettings.platformHalfLength = platformHalfLength;
+	chunkSettings.minGap = minGap;
+	chunkSettings.maxGap = FMath::Max(maxGap, minGap);
+	chunkSettings.maxHeightStep = maxHeightStep;
+	chunkSettings.maxYawStep = maxYawStep;
+	chunkSettings.jump.jumpZVelocity = movement->JumpZVelocity;
+	chunkSettings.jump.gravity = -movement->GetGravityZ();
+	chunkSettings.jump.runSpeed = movement->MaxWalkSpeed;
+	chunkSettings.jump.safety = jumpSafety;
+
+	// Si el salto en plano no llega al hueco minimo, el minimo se achica para que todo salto siga siendo posible
+	const float flatReach = chunkSettings.jump.GetReach(0.0f);
+	if (flatReach <= chunkSettings.minGap)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EndlessParkourGenerator: minGap %.1f supera el alcance del salto %.1f, se usa %.1f"), chunkSettings.minGap, flatReach, flatReach * 0.9f);
+		chunkSettings.minGap = flatReach * 0.9f;
+		chunkSettings.maxGap = FMath::Max(chunkSettings.maxGap, chunkSettings.minGap);
+	}
+	return true;
+}
+
+void AEndlessParkourGenerator::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// El personaje puede no existir todavia en el primer frame
+	if (!bHasSettings)
+	{
+		bHasSettings = GatherSettings();
+		if (!bHasSettings)
+		{
+			return;
+		}
+	}
+
+	if (chunkFuture.IsValid() && chunkFuture.IsReady())
+	{
+		ReceiveChunk(chunkFuture.Get());
+		chunkFuture = TFuture<FEndlessChunkLayout>();
+	}
+
+	UpdatePlayerChunk();
+
+	// Un solo chunk en camino a la vez: cada uno empieza donde termina el anterior
+	const int32 generatedChunks = nextChunkIndex;
+	if (!chunkFuture.IsValid() && generatedChunks <= playerChunkIndex + chunksAhead)
+	{
+		RequestNextChunk();
+	}
+
+	if (pendingLayouts.Num() > 0)
+	{
+		SpawnPendingPlatforms();
+	}
+}
+
+void AEndlessParkourGenerator::ResetToStart()
+{
+	// El resultado de un chunk en camino se descarta, el futuro vacio suelta su estado compartido
+	chunkFuture = TFuture<FEndlessChunkLayout>();
+
+	for (FEndlessChunk& chunk : chunks)
+	{
+		RecycleChunk(chunk);
+	}
+	chunks.Reset();
+	pendingLayouts.Reset();
+	nextPendingPlatform = 0;
+	playerChunkIndex = 0;
+	nextChunkIndex = 0;
+	nextChunkStart = GetActorTransform();
+	nextChunkStart.SetScale3D(FVector::OneVector);
+
+	if (!bHasSettings)
+	{
+		return;
+	}
+
+	// El primer chunk se arma ahora con las plataformas del pool para que el jugador tenga donde pararse
+	ReceiveChunk(GenerateChunk(nextChunkIndex++, nextChunkStart, chunkSettings));
+	while (pendingLayouts.Num() > 0)
+	{
+		SpawnPendingPlatforms();
+	}
+}
+
+void AEndlessParkourGenerator::RequestNextChunk()
+{
+	const int32 chunkIndex = nextChunkIndex++;
+	const FTransform startTransform = nextChunkStart;
+	const FEndlessChunkSettings settings = chunkSettings;
+	chunkFuture = Async(EAsyncExecution::ThreadPool, [chunkIndex, startTransform, settings]()
+	{
+		return GenerateChunk(chunkIndex, startTransform, settings);
+	});
+}
+
+FEndlessChunkLayout AEndlessParkourGenerator::GenerateChunk(int32 chunkIndex, const FTransform& startTransform, const FEndlessChunkSettings& settings)
+{
+	// Cada chunk tiene su propia semilla, el resultado solo depende de la semilla y de donde termino el anterior
+	FRandomStream randomStream(HashCombine(GetTypeHash(settings.seed), GetTypeHash(chunkIndex)));
+
+	FEndlessChunkLayout layout;
+	layout.chunkIndex = chunkIndex;
+	layout.platformTransforms.Reserve(settings.platformsPerChunk);
+
+	FVector location = startTransform.GetLocation();
+	float yaw = startTransform.Rotator().Yaw;
+	for (int32 i = 0; i < settings.platformsPerChunk; i++)
+	{
+		if (chunkIndex > 0 || i > 0)
+		{
+			float heightStep = randomStream.FRandRange(-settings.maxHeightStep, settings.maxHeightStep);
+			float gap = randomStream.FRandRange(settings.minGap, settings.maxGap);
+
+			// Si el salto no llega se achica el escalon y despues el hueco, siempre queda un camino posible
+			float reach = settings.jump.GetReach(heightStep);
+			if (reach <= settings.minGap)
+			{
+				heightStep = FMath::Min(heightStep, 0.0f);
+				reach = settings.jump.GetReach(heightStep);
+			}
+			gap = FMath::Clamp(gap, 0.0f, FMath::Max(reach, settings.minGap));
+
+			yaw += randomStream.FRandRange(-settings.maxYawStep, settings.maxYawStep);
+			const FVector direction = FRotator(0.0f, yaw, 0.0f).Vector();
+			location += direction * (gap + 2.0f * settings.platformHalfLength);
+			location.Z += heightStep;
+		}
+		layout.platformTransforms.Add(FTransform(FRotator(0.0f, yaw, 0.0f), location));
+	}
+
+	layout.endTransform = FTransform(FRotator(0.0f, yaw, 0.0f), location);
+	return layout;
+}
+
+void AEndlessParkourGenerator::ReceiveChunk(const FEndlessChunkLayout& layout)
+{
+	nextChunkStart = layout.endTransform;
+	pendingLayouts.Add(layout);
+}
+
+void AEndlessParkourGenerator::SpawnPendingPlatforms()
+{
+	int32 spawnsThisFrame = 0;
+	while (pendingLayouts.Num() > 0 && spawnsThisFrame < maxSpawnsPerFrame)
+	{
+		FEndlessChunkLayout& layout = pendingLayouts[0];
+		if (nextPendingPlatform == 0)
+		{
+			FEndlessChunk chunk;
+			chunk.chunkIndex = layout.chunkIndex;
+			chunk.bounds = FBox(ForceInit);
+			chunks.Add(chunk);
+		}
+		FEndlessChunk& chunk = chunks.Last();
+
+		const FTransform& transform = layout.platformTransforms[nextPendingPlatform++];
+		APlatformPawn* platform = AcquirePlatform(transform);
+		if (platform != nullptr)
+		{
+			chunk.platforms.Add(platform);
+			chunk.bounds += transform.GetLocation();
+		}
+		spawnsThisFrame++;
+
+		if (nextPendingPlatform >= layout.platformTransforms.Num())
+		{
+			chunk.bounds = chunk.bounds.ExpandBy(FVector(platformHalfLength, platformHalfLength, 0.0f));
+			pendingLayouts.RemoveAt(0);
+			nextPendingPlatform = 0;
+		}
+	}
+}
+
+void AEndlessParkourGenerator::UpdatePlayerChunk()
+{
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (player == nullptr || chunks.Num() == 0)
+	{
+		return;
+	}
+	const FVector playerLocation = player->GetActorLocation();
+	float closestDistance = MAX_flt;
+	for (const FEndlessChunk& chunk : chunks)
+	{
+		if (!chunk.bounds.IsValid)
+		{
+			continue;
+		}
+		const float distance = chunk.bounds.ComputeSquaredDistanceToPoint(playerLocation);
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			playerChunkIndex = chunk.chunkIndex;
+		}
+	}
+
+	// Los chunks que quedaron atras devuelven sus plataformas al pool
+	for (int32 i = chunks.Num() - 1; i >= 0; i--)
+	{
+		if (chunks[i].chunkIndex < playerChunkIndex - chunksBehind)
+		{
+			RecycleChunk(chunks[i]);
+			chunks.RemoveAt(i);
+		}
+	}
+}
+
+void AEndlessParkourGenerator::RecycleChunk(FEndlessChunk& chunk)
+{
+	for (APlatformPawn* platform : chunk.platforms)
+	{
+		if (platform != nullptr && !platform->IsPendingKill())
+		{
+			platform->SetActorHiddenInGame(true);
+			platform->SetActorEnableCollision(false);
+			freePlatforms.Add(platform);
+		}
+	}
+	chunk.platforms.Reset();
+}
+
+APlatformPawn* AEndlessParkourGenerator::AcquirePlatform(const FTransform& transform)
+{
+	while (freePlatforms.Num() > 0)
+	{
+		APlatformPawn* platform = freePlatforms.Pop(false);
+		if (platform == nullptr || platform->IsPendingKill())
+		{
+			continue;
+		}
+		platform->SetActorTransform(transform, false, nullptr, ETeleportType::TeleportPhysics);
+		platform->SetActorHiddenInGame(false);
+		platform->SetActorEnableCollision(true);
+		platform->bIsTread = false;
+
+		UPlatformRegistrySubsystem* platformRegistry = GetWorld()->GetSubsystem<UPlatformRegistrySubsystem>();
+		if (platformRegistry != nullptr)
+		{
+			platformRegistry->UpdatePlatform(platform->GetPlatformId());
+		}
+		return platform;
+	}
+
+	APlatformPawn* platform = GetWorld()->SpawnActorDeferred<APlatformPawn>(platformClass, transform, this, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (platform == nullptr)
+	{
+		return nullptr;
+	}
+	// Las plataformas generadas son estaticas, asi no entran al sistema de movimiento
+	platform->isStatic = true;
+	platform->length = platformHalfLength;
+	platform->wight = platformHalfWidth;
+	UGameplayStatics::FinishSpawningActor(platform, transform);
+	allPlatforms.Add(platform);
+	return platform;
+}
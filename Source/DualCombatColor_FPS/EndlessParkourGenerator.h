@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Async/Future.h"
+#include "EndlessParkourGenerator.generated.h"
+
+class APlatformPawn;
+
+/** Jump limits of the player, copied from its movement component so worker threads can use them. */
+struct FEndlessJumpSettings
+{
+	float jumpZVelocity;
+	float gravity;
+	float runSpeed;
+	/** Fraction of the theoretical reach a jump is allowed to need. */
+	float safety;
+
+	/** Horizontal distance covered by a jump that lands heightDelta above the take off, 0 if the height can not be reached. */
+	float GetReach(float heightDelta) const;
+};
+
+struct FEndlessChunkSettings
+{
+	int32 seed;
+	int32 platformsPerChunk;
+	float platformHalfLength;
+	float minGap;
+	float maxGap;
+	float maxHeightStep;
+	float maxYawStep;
+	FEndlessJumpSettings jump;
+};
+
+/** Result of generating a chunk: platform transforms and where the next chunk starts. */
+struct FEndlessChunkLayout
+{
+	int32 chunkIndex;
+	TArray<FTransform> platformTransforms;
+	FTransform endTransform;
+};
+
+struct FEndlessChunk
+{
+	int32 chunkIndex;
+	FBox bounds;
+	TArray<APlatformPawn*> platforms;
+};
+
+/**
+ * Endless parkour mode. Generates chunks of APlatformPawn ahead of the player on the thread
+ * pool, deterministic from the seed, and checks every gap against the player's jump arc.
+ * Chunks left behind give their platforms back to a pool that the next chunks reuse, so
+ * the number of platforms stays the same no matter how far the player runs.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API AEndlessParkourGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AEndlessParkourGenerator();
+
+	virtual void Tick(float DeltaTime) override;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		TSubclassOf<APlatformPawn> platformClass;
+
+	/** 0 picks a different seed every run. */
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		int32 seed = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		int32 platformsPerChunk = 12;
+
+	/** Chunks kept generated in front of the chunk the player is on. */
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		int32 chunksAhead = 3;
+
+	/** Chunks kept behind the player before their platforms are recycled. */
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		int32 chunksBehind = 1;
+
+	/** Half the length of a platform along the path, used to turn center distances into gaps. */
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		float platformHalfLength = 150.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		float platformHalfWidth = 150.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		float minGap = 100.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		float maxGap = 500.0f;
+
+	/** Largest height difference between two platforms, up or down. Higher steps are clamped by the jump arc. */
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		float maxHeightStep = 150.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		float maxYawStep = 30.0f;
+
+	/** Fraction of the player's full jump reach a gap may use. */
+	UPROPERTY(EditAnywhere, Category = "Endless", meta = (ClampMin = "0.1", ClampMax = "1"))
+		float jumpSafety = 0.8f;
+
+	UPROPERTY(EditAnywhere, Category = "Endless")
+		int32 maxSpawnsPerFrame = 4;
+
+	/**
+	 * Recycles every generated platform and lays out the first chunk again from the seed,
+	 * as when the level started. Used when the level is restored without reloading it.
+	 */
+	void ResetToStart();
+
+	/** Lays out one chunk. Only touches its arguments, so it runs on a worker thread. */
+	static FEndlessChunkLayout GenerateChunk(int32 chunkIndex, const FTransform& startTransform, const FEndlessChunkSettings& settings);
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	bool GatherSettings();
+	void RequestNextChunk();
+	void ReceiveChunk(const FEndlessChunkLayout& layout);
+	void SpawnPendingPlatforms();
+	void UpdatePlayerChunk();
+	void RecycleChunk(FEndlessChunk& chunk);
+	APlatformPawn* AcquirePlatform(const FTransform& transform);
+
+	FEndlessChunkSettings chunkSettings;
+	bool bHasSettings = false;
+
+	TFuture<FEndlessChunkLayout> chunkFuture;
+	int32 nextChunkIndex = 0;
+	FTransform nextChunkStart;
+
+	// Plataformas de chunks ya generados que faltan crear, en orden
+	TArray<FEndlessChunkLayout> pendingLayouts;
+	int32 nextPendingPlatform = 0;
+
+	TArray<FEndlessChunk> chunks;
+	int32 playerChunkIndex = 0;
+
+	UPROPERTY()
+		TArray<APlatformPawn*> freePlatforms;
+
+	UPROPERTY()
+		TArray<APlatformPawn*> allPlatforms;
+};
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayRoleActor.h"
+#include "GameFramework/Actor.h"
+
+EGameplayRole IGameplayRoleActor::GetActorRoles(const AActor* actor)
+{
+	if (actor == nullptr)
+	{
+		return EGameplayRole::None;
+	}
+	const IGameplayRoleActor* roleActor = Cast<IGameplayRoleActor>(actor);
+	return roleActor != nullptr ? roleActor->GetGameplayRoles() : GetRolesFromTags(actor);
+}
+
+EGameplayRole IGameplayRoleActor::GetRolesFromTags(const AActor* actor)
+{
+	static const FName playerTag(TEXT("Player"));
+	static const FName platformTag(TEXT("Plattform"));
+	static const FName victoryPointTag(TEXT("VictoryPoint"));
+	static const FName wallTag(TEXT("Pared"));
+
+	EGameplayRole roles = EGameplayRole::None;
+	for (const FName& tag : actor->Tags)
+	{
+		if (tag == playerTag)
+		{
+			roles |= EGameplayRole::Player;
+		}
+		else if (tag == platformTag)
+		{
+			roles |= EGameplayRole::Platform;
+		}
+		else if (tag == victoryPointTag)
+		{
+			roles |= EGameplayRole::VictoryPoint;
+		}
+		else if (tag == wallTag)
+		{
+			roles |= EGameplayRole::Wall;
+		}
+	}
+	return roles;
+}
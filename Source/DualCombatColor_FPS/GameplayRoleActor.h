@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "GameplayRoleActor.generated.h"
+
+/** Gameplay roles of an actor, combined as a bitmask. */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGameplayRole : uint8
+{
+	None			= 0,
+	Player			= 1 << 0,
+	Platform		= 1 << 1,
+	VictoryPoint	= 1 << 2,
+	Wall			= 1 << 3,
+	Target			= 1 << 4,
+};
+ENUM_CLASS_FLAGS(EGameplayRole)
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UGameplayRoleActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by the gameplay actors, which return the fixed role of their class plus the
+ * roles of their current tags. Collision callbacks classify the other actor with one AND on
+ * the result instead of comparing tag names. Actors that do not implement it (walls, Blueprint
+ * actors authored with the old "Player", "Plattform", "VictoryPoint" and "Pared" tags) fall
+ * back to their tags.
+ */
+class DUALCOMBATCOLOR_FPS_API IGameplayRoleActor
+{
+	GENERATED_BODY()
+public:
+	virtual EGameplayRole GetGameplayRoles() const = 0;
+
+	/** Roles of the actor from the interface, or from its tags if it does not implement it. */
+	static EGameplayRole GetActorRoles(const AActor* actor);
+
+	static EGameplayRole GetRolesFromTags(const AActor* actor);
+};
@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameplayTimingWheelSubsystem.h"
+#include "Engine/World.h"
+
+void UGameplayTimingWheelSubsystem::Deinitialize()
+{
+	timers.Empty();
+	cohortTimers.Empty();
+	staggerCounters.Empty();
+	ResetWheel();
+	Super::Deinitialize();
+}
+
+FGameplayTimerHandle UGameplayTimingWheelSubsystem::SetTimer(const FTimerDelegate& delegate, float delay, bool bLooping, int32 cohort, bool bStaggerPhase)
+{
+	FGameplayTimerHandle handle;
+	if (delay <= 0.0f || !delegate.IsBound())
+	{
+		return handle;
+	}
+
+	FWheelTimer timer;
+	timer.delegate = delegate;
+	timer.periodTicks = SecondsToTicks(delay);
+	timer.cohort = cohort;
+	timer.bLooping = bLooping;
+	const uint32 firstDelay = (bLooping && bStaggerPhase) ? GetStaggerPhase(timer.periodTicks) : timer.periodTicks;
+	timer.expireTick = currentTick + firstDelay;
+
+	handle.id = nextTimerId++;
+	timers.Add(handle.id, MoveTemp(timer));
+	if (cohort != INDEX_NONE)
+	{
+		cohortTimers.FindOrAdd(cohort).Add(handle.id);
+	}
+	Insert(handle.id);
+	return handle;
+}
+
+void UGameplayTimingWheelSubsystem::ClearTimer(FGameplayTimerHandle& handle)
+{
+	// Los slots se limpian de forma perezosa: un id que ya no esta en timers se ignora al procesarlo
+	timers.Remove(handle.id);
+	handle.Invalidate();
+	if (timers.Num() == 0)
+	{
+		ResetWheel();
+	}
+}
+
+bool UGameplayTimingWheelSubsystem::IsTimerActive(const FGameplayTimerHandle& handle) const
+{
+	return handle.IsValid() && timers.Contains(handle.id);
+}
+
+int32 UGameplayTimingWheelSubsystem::CreateCohort()
+{
+	return nextCohort++;
+}
+
+void UGameplayTimingWheelSubsystem::ExpireCohort(int32 cohort)
+{
+	TArray<uint64> ids;
+	if (!cohortTimers.RemoveAndCopyValue(cohort, ids))
+	{
+		return;
+	}
+	TArray<FTimerDelegate> delegates;
+	delegates.Reserve(ids.Num());
+	for (uint64 id : ids)
+	{
+		FWheelTimer timer;
+		if (timers.RemoveAndCopyValue(id, timer))
+		{
+			delegates.Add(MoveTemp(timer.delegate));
+		}
+	}
+	for (FTimerDelegate& delegate : delegates)
+	{
+		delegate.ExecuteIfBound();
+	}
+}
+
+void UGameplayTimingWheelSubsystem::ClearCohort(int32 cohort)
+{
+	TArray<uint64> ids;
+	if (cohortTimers.RemoveAndCopyValue(cohort, ids))
+	{
+		for (uint64 id : ids)
+		{
+			timers.Remove(id);
+		}
+		if (timers.Num() == 0)
+		{
+			ResetWheel();
+		}
+	}
+}
+
+void UGameplayTimingWheelSubsystem::Tick(float DeltaTime)
+{
+	accumulatedTime += DeltaTime;
+	const uint64 tickCount = (uint64)FMath::FloorToInt(accumulatedTime / tickSeconds);
+	accumulatedTime -= tickCount * tickSeconds;
+	AdvanceTicks(tickCount);
+}
+
+bool UGameplayTimingWheelSubsystem::IsTickable() const
+{
+	return !IsTemplate();
+}
+
+TStatId UGameplayTimingWheelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplayTimingWheelSubsystem, STATGROUP_Tickables);
+}
+
+uint32 UGameplayTimingWheelSubsystem::SecondsToTicks(float seconds) const
+{
+	return (uint32)FMath::Max(1, FMath::RoundToInt(seconds / tickSeconds));
+}
+
+uint32 UGameplayTimingWheelSubsystem::GetStaggerPhase(uint32 periodTicks)
+{
+	// Secuencia de razon aurea: cada timer nuevo con el mismo periodo cae en el hueco mas grande que queda
+	uint32& counter = staggerCounters.FindOrAdd(periodTicks);
+	const float fraction = FMath::Frac(counter * 0.6180339887f);
+	counter++;
+	return FMath::Clamp<uint32>(1 + (uint32)(fraction * periodTicks), 1, periodTicks);
+}
+
+void UGameplayTimingWheelSubsystem::ResetWheel()
+{
+	for (int32 level = 0; level < LevelCount; level++)
+	{
+		for (int32 slot = 0; slot < SlotCount; slot++)
+		{
+			wheel[level][slot].Reset();
+		}
+	}
+	overflow.Reset();
+}
+
+void UGameplayTimingWheelSubsystem::Insert(uint64 id)
+{
+	FWheelTimer* timer = timers.Find(id);
+	if (timer == nullptr)
+	{
+		return;
+	}
+	// Durante la cascada un timer puede vencer en el tick actual, que se dispara justo despues
+	if (timer->expireTick < currentTick)
+	{
+		timer->expireTick = currentTick;
+	}
+	const uint64 delta = timer->expireTick - currentTick;
+	if (delta < (1ull << SlotBits))
+	{
+		wheel[0][timer->expireTick & SlotMask].Add(id);
+	}
+	else if (delta < (1ull << (SlotBits * 2)))
+	{
+		wheel[1][(timer->expireTick >> SlotBits) & SlotMask].Add(id);
+	}
+	else if (delta < (1ull << (SlotBits * 3)))
+	{
+		wheel[2][(timer->expireTick >> (SlotBits * 2)) & SlotMask].Add(id);
+	}
+	else
+	{
+		overflow.Add(id);
+	}
+}
+
+void UGameplayTimingWheelSubsystem::Reinsert(TArray<uint64>& slot)
+{
+	if (slot.Num() == 0)
+	{
+		return;
+	}
+	TArray<uint64> ids = MoveTemp(slot);
+	slot.Reset();
+	for (uint64 id : ids)
+	{
+		Insert(id);
+	}
+}
+
+void UGameplayTimingWheelSubsystem::Cascade()
+{
+	if ((currentTick & SlotMask) != 0)
+	{
+		return;
+	}
+	// Se baja primero el nivel mas alto para que sus timers puedan seguir cayendo en los niveles inferiores
+	if (((currentTick >> SlotBits) & SlotMask) == 0)
+	{
+		if (((currentTick >> (SlotBits * 2)) & SlotMask) == 0)
+		{
+			Reinsert(overflow);
+		}
+		Reinsert(wheel[2][(currentTick >> (SlotBits * 2)) & SlotMask]);
+	}
+	Reinsert(wheel[1][(currentTick >> SlotBits) & SlotMask]);
+}
+
+void UGameplayTimingWheelSubsystem::FireSlot(int32 slot)
+{
+	if (wheel[0][slot].Num() == 0)
+	{
+		return;
+	}
+	TArray<uint64> ids = MoveTemp(wheel[0][slot]);
+	wheel[0][slot].Reset();
+	for (uint64 id : ids)
+	{
+		FWheelTimer* timer = timers.Find(id);
+		if (timer == nullptr)
+		{
+			continue;
+		}
+		if (timer->expireTick != currentTick)
+		{
+			Insert(id);
+			continue;
+		}
+
+		FTimerDelegate delegate = timer->delegate;
+		if (timer->bLooping)
+		{
+			timer->expireTick += timer->periodTicks;
+			Insert(id);
+		}
+		else
+		{
+			timers.Remove(id);
+		}
+		// El delegate puede crear o cancelar timers, por eso se ejecuta sin referencias a timers
+		delegate.ExecuteIfBound();
+	}
+}
+
+void UGameplayTimingWheelSubsystem::AdvanceTicks(uint64 tickCount)
+{
+	if (timers.Num() == 0)
+	{
+		// Sin timers pendientes no hay nada que disparar, ResetWheel ya vacio los slots
+		currentTick += tickCount;
+		return;
+	}
+	for (uint64 i = 0; i < tickCount; i++)
+	{
+		currentTick++;
+		Cascade();
+		FireSlot(currentTick & SlotMask);
+	}
+}
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TimerManager.h"
+#include "GameplayTimingWheelSubsystem.generated.h"
+
+/** Cancellable reference to a timer scheduled in UGameplayTimingWheelSubsystem. */
+struct FGameplayTimerHandle
+{
+	uint64 id = 0;
+
+	FORCEINLINE bool IsValid() const { return id != 0; }
+	FORCEINLINE void Invalidate() { id = 0; }
+};
+
+/**
+ * Hierarchical timing wheel that owns the gameplay schedules of the level (canyon volleys,
+ * target lifetimes, round timers). Timers can be cancelled through their handle, grouped in
+ * cohorts that expire or are cancelled together, and looping timers with the same period can
+ * be phase staggered so they do not all fire on the same frame.
+ */
+UCLASS(config=Game)
+class DUALCOMBATCOLOR_FPS_API UGameplayTimingWheelSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Duration of one wheel tick in seconds. Timers are rounded to this resolution. */
+	UPROPERTY(Config)
+		float tickSeconds = 1.0f / 60.0f;
+
+	/**
+	 * Schedules the delegate. Like FTimerManager, a delay <= 0 schedules nothing and returns an invalid handle.
+	 * @param cohort		Group used by ExpireCohort/ClearCohort, INDEX_NONE for none.
+	 * @param bStaggerPhase	Spreads the first expiry of looping timers with the same period over that period.
+	 */
+	FGameplayTimerHandle SetTimer(const FTimerDelegate& delegate, float delay, bool bLooping, int32 cohort = INDEX_NONE, bool bStaggerPhase = false);
+
+	template<class UserClass>
+	FORCEINLINE FGameplayTimerHandle SetTimer(UserClass* object, typename FTimerDelegate::TUObjectMethodDelegate<UserClass>::FMethodPtr method, float delay, bool bLooping, int32 cohort = INDEX_NONE, bool bStaggerPhase = false)
+	{
+		return SetTimer(FTimerDelegate::CreateUObject(object, method), delay, bLooping, cohort, bStaggerPhase);
+	}
+
+	void ClearTimer(FGameplayTimerHandle& handle);
+
+	bool IsTimerActive(const FGameplayTimerHandle& handle) const;
+
+	/** Returns a new cohort id. */
+	int32 CreateCohort();
+
+	/** Fires every pending timer of the cohort now and removes them, looping ones included. */
+	void ExpireCohort(int32 cohort);
+
+	/** Removes every timer of the cohort without firing them. */
+	void ClearCohort(int32 cohort);
+
+	FORCEINLINE int32 GetTimerCount() const { return timers.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject
+
+private:
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotCount = 1 << SlotBits;
+	static constexpr uint64 SlotMask = SlotCount - 1;
+	static constexpr int32 LevelCount = 3;
+
+	struct FWheelTimer
+	{
+		FTimerDelegate delegate;
+		uint64 expireTick = 0;
+		uint32 periodTicks = 0;
+		int32 cohort = INDEX_NONE;
+		bool bLooping = false;
+	};
+
+	uint32 SecondsToTicks(float seconds) const;
+	uint32 GetStaggerPhase(uint32 periodTicks);
+	void ResetWheel();
+	void Insert(uint64 id);
+	void Reinsert(TArray<uint64>& slot);
+	void Cascade();
+	void FireSlot(int32 slot);
+	void AdvanceTicks(uint64 tickCount);
+
+	TMap<uint64, FWheelTimer> timers;
+	TMap<int32, TArray<uint64>> cohortTimers;
+	TMap<uint32, uint32> staggerCounters;
+
+	TArray<uint64> wheel[LevelCount][SlotCount];
+	TArray<uint64> overflow;
+
+	uint64 currentTick = 0;
+	uint64 nextTimerId = 1;
+	int32 nextCohort = 0;
+	float accumulatedTime = 0.0f;
+};
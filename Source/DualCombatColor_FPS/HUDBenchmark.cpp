@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SVirtualWindow.h"
+#include "Layout/Geometry.h"
+#include "Layout/SlateRect.h"
+#include "Rendering/DrawElements.h"
+#include "Input/HittestGrid.h"
+#include "Styling/WidgetStyle.h"
+#include "UI_PlayerWidget.h"
+
+namespace HUDBenchmark
+{
+	/** HUD the character uses, with the text blocks bound by the designer. */
+	static const TCHAR* WidgetClassPath = TEXT("/Game/DualCombatColor/Bluprints/UI_PlayerWidget_BP.UI_PlayerWidget_BP_C");
+
+	struct FResult
+	{
+		double prepassMs = 0.0;
+		double tickMs = 0.0;
+		double paintMs = 0.0;
+	};
+
+	/**
+	 * Lays out, ticks and paints the HUD into an element list for the given frames. Nothing is
+	 * sent to the renderer, so it runs with -nullrhi. When bChangeEveryFrame, the score and life
+	 * change each frame like during a damage burst.
+	 */
+	FResult Run(TSubclassOf<UUI_PlayerWidget> widgetClass, bool bUseInvalidationPanel, bool bChangeEveryFrame, int32 frames)
+	{
+		FResult result;
+		UUI_PlayerWidget* widget = NewObject<UUI_PlayerWidget>(GetTransientPackage(), widgetClass);
+		widget->bUseInvalidationPanel = bUseInvalidationPanel;
+		widget->Initialize();
+		TSharedRef<SWidget> slateWidget = widget->TakeWidget();
+
+		const FVector2D drawSize(1280.0f, 720.0f);
+		const float deltaTime = 1.0f / 60.0f;
+		TSharedRef<SVirtualWindow> window = SNew(SVirtualWindow).Size(drawSize);
+		window->SetContent(slateWidget);
+
+		const FGeometry geometry = FGeometry::MakeRoot(drawSize, FSlateLayoutTransform());
+		const FSlateRect cullingRect(FVector2D::ZeroVector, drawSize);
+		FSlateWindowElementList elementList(window);
+		FHittestGrid hittestGrid;
+		double currentTime = 0.0;
+
+		// Tick y paint van separados: el tick del HUD vuelca el view-model a los textos y el paint de 4.25
+		// solo vuelve a tickear lo que quedo marcado, asi cada cifra mide su parte
+		auto runFrame = [&](FResult* frameResult)
+		{
+			const double prepassStart = FPlatformTime::Seconds();
+			window->SlatePrepass(1.0f);
+			const double tickStart = FPlatformTime::Seconds();
+			slateWidget->Tick(geometry, currentTime, deltaTime);
+			const double paintStart = FPlatformTime::Seconds();
+			elementList.ResetElementList();
+			hittestGrid.SetHittestArea(FVector2D::ZeroVector, drawSize);
+			window->Paint(FPaintArgs(nullptr, hittestGrid, FVector2D::ZeroVector, currentTime, deltaTime), geometry, cullingRect, elementList, 0, FWidgetStyle(), true);
+			const double paintEnd = FPlatformTime::Seconds();
+			currentTime += deltaTime;
+
+			if (frameResult != nullptr)
+			{
+				frameResult->prepassMs += (tickStart - prepassStart) * 1000.0;
+				frameResult->tickMs += (paintStart - tickStart) * 1000.0;
+				frameResult->paintMs += (paintEnd - paintStart) * 1000.0;
+			}
+		};
+
+		// Un frame sin medir para que los textos y el cache del panel esten listos
+		runFrame(nullptr);
+
+		for (int32 frame = 0; frame < frames; frame++)
+		{
+			if (bChangeEveryFrame)
+			{
+				widget->SetScoreText(frame);
+				widget->SetCurrentLifeText(100 - frame % 100);
+			}
+			runFrame(&result);
+		}
+
+		result.prepassMs /= FMath::Max(frames, 1);
+		result.tickMs /= FMath::Max(frames, 1);
+		result.paintMs /= FMath::Max(frames, 1);
+		return result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDWidgetCostTest, "DualCombatColor_FPS.UI.HUDWidgetCost", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FHUDWidgetCostTest::RunTest(const FString& Parameters)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		AddError(TEXT("Slate is not initialized, the HUD can not be laid out"));
+		return false;
+	}
+	UClass* widgetClass = LoadClass<UUI_PlayerWidget>(nullptr, HUDBenchmark::WidgetClassPath);
+	if (!TestNotNull(TEXT("Player HUD widget class"), widgetClass))
+	{
+		return false;
+	}
+
+	const int32 frames = 300;
+	for (int32 changing = 0; changing < 2; changing++)
+	{
+		for (int32 invalidation = 0; invalidation < 2; invalidation++)
+		{
+			const HUDBenchmark::FResult result = HUDBenchmark::Run(widgetClass, invalidation != 0, changing != 0, frames);
+			AddInfo(FString::Printf(TEXT("%s HUD, %s invalidation panel (%d frames): prepass %.4f ms, tick %.4f ms, paint %.4f ms"),
+				changing != 0 ? TEXT("Changing") : TEXT("Steady"), invalidation != 0 ? TEXT("with") : TEXT("without"), frames,
+				result.prepassMs, result.tickMs, result.paintMs));
+		}
+	}
+	return true;
+}
+
+#endif
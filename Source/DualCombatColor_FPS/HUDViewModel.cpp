@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HUDViewModel.h"
+
+#define LOCTEXT_NAMESPACE "HUDViewModel"
+
+FHUDViewModel::FHUDViewModel()
+{
+	fields[(int32)EHUDField::Score].format = LOCTEXT("ScoreFormat", "Score: {0}");
+	fields[(int32)EHUDField::Level].format = LOCTEXT("LevelFormat", "Level {0}");
+	fields[(int32)EHUDField::Life].format = LOCTEXT("LifeFormat", "Life: {0}");
+}
+
+void FHUDViewModel::SetValue(EHUDField field, int32 value)
+{
+	FField& data = fields[(int32)field];
+	if (data.value != value)
+	{
+		data.value = value;
+		data.bDirty = true;
+		bAnyDirty = true;
+	}
+}
+
+const FText& FHUDViewModel::ConsumeText(EHUDField field)
+{
+	FField& data = fields[(int32)field];
+	data.bDirty = false;
+
+	const FText* cached = data.textCache.Find(data.value);
+	if (cached != nullptr)
+	{
+		return *cached;
+	}
+	if (data.textCache.Num() >= MaxCachedTexts)
+	{
+		data.textCache.Reset();
+	}
+	return data.textCache.Add(data.value, FText::Format(data.format, FText::AsNumber(data.value, &FNumberFormattingOptions::DefaultNoGrouping())));
+}
+
+void FHUDViewModel::MarkAllDirty()
+{
+	for (FField& data : fields)
+	{
+		data.bDirty = true;
+	}
+	bAnyDirty = true;
+}
+
+#undef LOCTEXT_NAMESPACE
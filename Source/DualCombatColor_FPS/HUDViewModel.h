@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EHUDField : uint8
+{
+	Score,
+	Level,
+	Life,
+	Count
+};
+
+/**
+ * Plain values shown by the player HUD. Setters only store the value and mark the field dirty;
+ * the widget reads the dirty fields once per frame. Formatted texts are cached per value, so a
+ * value seen before (full life, a previous score) does not build a new FText.
+ */
+class DUALCOMBATCOLOR_FPS_API FHUDViewModel
+{
+public:
+	FHUDViewModel();
+
+	void SetValue(EHUDField field, int32 value);
+
+	FORCEINLINE int32 GetValue(EHUDField field) const { return fields[(int32)field].value; }
+	FORCEINLINE bool IsDirty(EHUDField field) const { return fields[(int32)field].bDirty; }
+	FORCEINLINE bool HasDirtyFields() const { return bAnyDirty; }
+
+	/** Formatted text of the current value. Clears the dirty flag of the field. */
+	const FText& ConsumeText(EHUDField field);
+
+	/** Marks every field dirty, for a widget that was just added to the viewport. */
+	void MarkAllDirty();
+
+	void ClearDirty() { bAnyDirty = false; }
+
+private:
+	struct FField
+	{
+		int32 value = 0;
+		bool bDirty = true;
+		FTextFormat format;
+		TMap<int32, FText> textCache;
+	};
+
+	// Limite de textos guardados por campo, el puntaje puede crecer sin fin
+	static const int32 MaxCachedTexts = 128;
+
+	FField fields[(int32)EHUDField::Count];
+	bool bAnyDirty = true;
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HealthComponent.h"
+
+UHealthComponent::UHealthComponent()
+{
+	// Solo tickea el frame en que hay que avisar un cambio
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UHealthComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	life = maxLife;
+	reportedLife = life;
+}
+
+void UHealthComponent::ApplyDamage(int32 damage, AActor* damageCauser)
+{
+	if (bDead || damage == 0)
+	{
+		return;
+	}
+	life = FMath::Max(life - damage, 0);
+	if (life <= 0)
+	{
+		bDead = true;
+		bDeathPending = true;
+	}
+	SetComponentTickEnabled(true);
+}
+
+void UHealthComponent::SetLife(int32 newLife)
+{
+	life = newLife;
+	reportedLife = life;
+	bDead = life <= 0;
+	bDeathPending = false;
+	SetComponentTickEnabled(false);
+	OnHealthChanged.Broadcast(life, 0);
+}
+
+void UHealthComponent::ResetHealth()
+{
+	SetLife(maxLife);
+}
+
+void UHealthComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	SetComponentTickEnabled(false);
+
+	if (life != reportedLife)
+	{
+		const int32 delta = life - reportedLife;
+		reportedLife = life;
+		OnHealthChanged.Broadcast(life, delta);
+	}
+	if (bDeathPending)
+	{
+		bDeathPending = false;
+		OnDeath.Broadcast();
+	}
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HealthComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHealthChanged, int32, newLife, int32, delta);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDeath);
+
+/**
+ * Life of an actor. All damage goes through ApplyDamage. Changes made in the same frame
+ * are coalesced and broadcast once at the end of the frame, so several hits at once only
+ * update the UI once. The component only ticks on the frames it has something to report.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class DUALCOMBATCOLOR_FPS_API UHealthComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHealthComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+		int32 maxLife = 100;
+
+	/** Called once per frame with the final life when it changed. */
+	UPROPERTY(BlueprintAssignable)
+		FOnHealthChanged OnHealthChanged;
+
+	/** Called once when the life reaches 0. */
+	UPROPERTY(BlueprintAssignable)
+		FOnDeath OnDeath;
+
+	/** Takes damage from the life. Does nothing once the owner is dead. */
+	UFUNCTION(BlueprintCallable)
+		void ApplyDamage(int32 damage, AActor* damageCauser = nullptr);
+
+	/** Sets the life without coalescing and revives the owner if it was dead. */
+	UFUNCTION(BlueprintCallable)
+		void SetLife(int32 newLife);
+
+	/** Back to maxLife and alive. */
+	UFUNCTION(BlueprintCallable)
+		void ResetHealth();
+
+	UFUNCTION(BlueprintPure)
+		FORCEINLINE int32 GetLife() const { return life; }
+
+	UFUNCTION(BlueprintPure)
+		FORCEINLINE bool IsDead() const { return bDead; }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	int32 life = 0;
+	// Vida al final del ultimo aviso, para mandar el cambio acumulado del frame
+	int32 reportedLife = 0;
+	bool bDead = false;
+	bool bDeathPending = false;
+};
@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InstancedTargetField.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "Engine/CollisionProfile.h"
+#include "DualCombatColor_GameMode.h"
+#include "PawnObjectDestructibleTarget.h"
+
+namespace InstancedTargetData
+{
+	static const int32 Team = 0;
+	static const int32 Flash = 1;
+	static const int32 Count = 2;
+
+	static const float Red = 0.0f;
+	static const float Blue = 1.0f;
+}
+
+AInstancedTargetField::AInstancedTargetField()
+{
+	// Solo tickea mientras haya objetivos golpeados esperando para convertirse en actor
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	redInstances = CreateTeamInstances(TEXT("RedInstances"), InstancedTargetData::Red);
+	blueInstances = CreateTeamInstances(TEXT("BlueInstances"), InstancedTargetData::Blue);
+}
+
+UHierarchicalInstancedStaticMeshComponent* AInstancedTargetField::CreateTeamInstances(const FName& name, float teamValue)
+{
+	UHierarchicalInstancedStaticMeshComponent* instances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(name);
+	instances->SetupAttachment(RootComponent);
+	instances->NumCustomDataFloats = InstancedTargetData::Count;
+	instances->SetMobility(EComponentMobility::Movable);
+	instances->SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
+	return instances;
+}
+
+void AInstancedTargetField::BeginPlay()
+{
+	Super::BeginPlay();
+}
+
+EGameplayRole AInstancedTargetField::GetGameplayRoles() const
+{
+	return EGameplayRole::Target | IGameplayRoleActor::GetRolesFromTags(this);
+}
+
+void AInstancedTargetField::SetGameMode(ADualCombatColor_GameMode* inGameMode)
+{
+	gameMode = inGameMode;
+}
+
+void AInstancedTargetField::SetTargetMesh(UStaticMesh* mesh)
+{
+	redInstances->SetStaticMesh(mesh);
+	blueInstances->SetStaticMesh(mesh);
+}
+
+void AInstancedTargetField::SetTargets(const TArray<FTransform>& blueTransforms, const TArray<FTransform>& redTransforms)
+{
+	pendingPromotions.Reset();
+	SetActorTickEnabled(false);
+	SetTeamTransforms(blueInstances, promotedBlue, blueTransforms, InstancedTargetData::Blue);
+	SetTeamTransforms(redInstances, promotedRed, redTransforms, InstancedTargetData::Red);
+	instancedTargetCount = blueTransforms.Num() + redTransforms.Num();
+}
+
+void AInstancedTargetField::ClearTargets()
+{
+	pendingPromotions.Reset();
+	SetActorTickEnabled(false);
+	redInstances->ClearInstances();
+	blueInstances->ClearInstances();
+	promotedRed.Reset();
+	promotedBlue.Reset();
+	instancedTargetCount = 0;
+}
+
+void AInstancedTargetField::SetTeamTransforms(UHierarchicalInstancedStaticMeshComponent* instances, TBitArray<>& promoted, const TArray<FTransform>& transforms, float teamValue)
+{
+	// Se reusan las instancias de la ronda anterior, solo se agregan o quitan las que sobran
+	const int32 count = transforms.Num();
+	int32 instanceCount = instances->GetInstanceCount();
+	while (instanceCount > count)
+	{
+		instances->RemoveInstance(--instanceCount);
+	}
+	while (instanceCount < count)
+	{
+		instances->AddInstanceWorldSpace(transforms[instanceCount++]);
+	}
+	if (count > 0)
+	{
+		instances->BatchUpdateInstancesTransforms(0, transforms, true, false, true);
+	}
+	for (int32 i = 0; i < count; i++)
+	{
+		instances->SetCustomDataValue(i, InstancedTargetData::Team, teamValue, false);
+		instances->SetCustomDataValue(i, InstancedTargetData::Flash, 0.0f, false);
+	}
+	instances->MarkRenderStateDirty();
+	promoted.Init(false, count);
+}
+
+bool AInstancedTargetField::OnInstanceHit(UPrimitiveComponent* component, int32 instanceIndex, const FVector& impulse, const FVector& location)
+{
+	const bool bBlueTeam = component == blueInstances;
+	if (!bBlueTeam && component != redInstances)
+	{
+		return false;
+	}
+	TBitArray<>& promoted = bBlueTeam ? promotedBlue : promotedRed;
+	if (!promoted.IsValidIndex(instanceIndex) || promoted[instanceIndex])
+	{
+		return true;
+	}
+	promoted[instanceIndex] = true;
+
+	UHierarchicalInstancedStaticMeshComponent* instances = bBlueTeam ? blueInstances : redInstances;
+	instances->SetCustomDataValue(instanceIndex, InstancedTargetData::Flash, 1.0f, true);
+
+	FPendingTargetPromotion promotion;
+	promotion.bBlueTeam = bBlueTeam;
+	promotion.instanceIndex = instanceIndex;
+	promotion.flashTimeLeft = hitFlashSeconds;
+	promotion.impulse = impulse;
+	promotion.impulseLocation = location;
+	pendingPromotions.Add(promotion);
+	SetActorTickEnabled(true);
+	return true;
+}
+
+void AInstancedTargetField::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (int32 i = pendingPromotions.Num() - 1; i >= 0; i--)
+	{
+		FPendingTargetPromotion& promotion = pendingPromotions[i];
+		promotion.flashTimeLeft -= DeltaTime;
+		if (promotion.flashTimeLeft <= 0.0f)
+		{
+			PromoteTarget(promotion);
+			pendingPromotions.RemoveAtSwap(i, 1, false);
+		}
+	}
+	if (pendingPromotions.Num() == 0)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void AInstancedTargetField::PromoteTarget(const FPendingTargetPromotion& promotion)
+{
+	UHierarchicalInstancedStaticMeshComponent* instances = promotion.bBlueTeam ? blueInstances : redInstances;
+	FTransform instanceTransform;
+	if (!instances->GetInstanceTransform(promotion.instanceIndex, instanceTransform, true))
+	{
+		return;
+	}
+
+	// La instancia se esconde con escala cero para no cambiar los indices de las demas
+	FTransform hiddenTransform = instanceTransform;
+	hiddenTransform.SetScale3D(FVector::ZeroVector);
+	instances->UpdateInstanceTransform(promotion.instanceIndex, hiddenTransform, true, true, true);
+	instancedTargetCount--;
+
+	if (!gameMode.IsValid())
+	{
+		return;
+	}
+	APawnObjectDestructibleTarget* target = gameMode->PromoteInstancedTarget(promotion.bBlueTeam, instanceTransform);
+	if (target == nullptr)
+	{
+		return;
+	}
+	TInlineComponentArray<UPrimitiveComponent*> primitiveComponents(target);
+	for (UPrimitiveComponent* component : primitiveComponents)
+	{
+		if (component->IsSimulatingPhysics())
+		{
+			component->AddImpulseAtLocation(promotion.impulse, promotion.impulseLocation);
+		}
+	}
+}
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GameplayRoleActor.h"
+#include "InstancedTargetField.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+class ADualCombatColor_GameMode;
+
+/** A hit instance waiting for its flash to end before it becomes a real target. */
+struct FPendingTargetPromotion
+{
+	bool bBlueTeam;
+	int32 instanceIndex;
+	float flashTimeLeft;
+	FVector impulse;
+	FVector impulseLocation;
+};
+
+/**
+ * Draws the round targets of each team as instances of one hierarchical instanced mesh.
+ * Per-instance custom data 0 is the team (0 red, 1 blue) and 1 is the hit flash, so the
+ * mesh material has to read them with PerInstanceCustomData. A hit instance flashes, is
+ * hidden and replaced by a pooled APawnObjectDestructibleTarget that takes the impulse.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API AInstancedTargetField : public AActor, public IGameplayRoleActor
+{
+	GENERATED_BODY()
+
+public:
+	AInstancedTargetField();
+
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaTime) override;
+
+	virtual EGameplayRole GetGameplayRoles() const override;
+
+	/** Seconds a hit instance flashes before being promoted to a physics actor. */
+	UPROPERTY(EditAnywhere)
+		float hitFlashSeconds = 0.05f;
+
+	void SetGameMode(ADualCombatColor_GameMode* inGameMode);
+
+	void SetTargetMesh(UStaticMesh* mesh);
+
+	/** Replaces the instances of both teams with the given transforms. */
+	void SetTargets(const TArray<FTransform>& blueTransforms, const TArray<FTransform>& redTransforms);
+
+	/** Removes every instance and drops the pending promotions. */
+	void ClearTargets();
+
+	/** Called by projectiles that hit one of the instanced meshes. Returns false if the component is not one of ours. */
+	bool OnInstanceHit(UPrimitiveComponent* component, int32 instanceIndex, const FVector& impulse, const FVector& location);
+
+	FORCEINLINE int32 GetInstancedTargetCount() const { return instancedTargetCount; }
+
+private:
+	UHierarchicalInstancedStaticMeshComponent* CreateTeamInstances(const FName& name, float teamValue);
+	void SetTeamTransforms(UHierarchicalInstancedStaticMeshComponent* instances, TBitArray<>& promoted, const TArray<FTransform>& transforms, float teamValue);
+	void PromoteTarget(const FPendingTargetPromotion& promotion);
+
+	UPROPERTY(VisibleAnywhere)
+		UHierarchicalInstancedStaticMeshComponent* redInstances;
+
+	UPROPERTY(VisibleAnywhere)
+		UHierarchicalInstancedStaticMeshComponent* blueInstances;
+
+	TWeakObjectPtr<ADualCombatColor_GameMode> gameMode;
+
+	// Instancias que ya se convirtieron en actor, para ignorar golpes repetidos
+	TBitArray<> promotedRed;
+	TBitArray<> promotedBlue;
+
+	TArray<FPendingTargetPromotion> pendingPromotions;
+
+	int32 instancedTargetCount = 0;
+};
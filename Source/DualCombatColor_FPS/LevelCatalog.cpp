@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelCatalog.h"
+#include "Engine/World.h"
+
+int32 ULevelCatalog::FindLevelIndex(const FString& mapName) const
+{
+	for (int32 i = 0; i < levels.Num(); i++)
+	{
+		if (levels[i].level.GetAssetName() == mapName)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+const FLevelCatalogEntry* ULevelCatalog::FindNextLevel(const FString& mapName) const
+{
+	const int32 index = FindLevelIndex(mapName);
+	if (index == INDEX_NONE || !levels.IsValidIndex(index + 1))
+	{
+		return nullptr;
+	}
+	return &levels[index + 1];
+}
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "LevelCatalog.generated.h"
+
+USTRUCT(BlueprintType)
+struct FLevelCatalogEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly)
+		TSoftObjectPtr<UWorld> level;
+
+	/** Distance from the victory point of the previous level at which this map starts loading in the background. */
+	UPROPERTY(EditDefaultsOnly)
+		float preloadDistance = 3000.0f;
+
+	/** Travel with UWorld::SeamlessTravel instead of OpenLevel. The game instance data survives both. */
+	UPROPERTY(EditDefaultsOnly)
+		bool bSeamlessTravel = false;
+};
+
+/**
+ * Ordered chain of the parkour maps. The victory point of each level uses it to know
+ * which map comes next and when to start preloading it.
+ */
+UCLASS(BlueprintType)
+class DUALCOMBATCOLOR_FPS_API ULevelCatalog : public UDataAsset
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditDefaultsOnly)
+		TArray<FLevelCatalogEntry> levels;
+
+	/** Index of the map with the given short name, or INDEX_NONE. */
+	int32 FindLevelIndex(const FString& mapName) const;
+
+	/** Entry that follows the map with the given short name, or nullptr if it is the last one or is not in the catalog. */
+	const FLevelCatalogEntry* FindNextLevel(const FString& mapName) const;
+};
@@ -0,0 +1,212 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelSnapshotSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "TimerManager.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "PlatformPawn.h"
+#include "ActorObstacleRay.h"
+#include "DualCombatColor_FPSCharacter.h"
+#include "ProjectilePoolSubsystem.h"
+#include "BulkProjectileSubsystem.h"
+#include "CheckpointSubsystem.h"
+#include "EndlessParkourGenerator.h"
+#include "PlatformMotionSubsystem.h"
+#include "DualCombatColor_GameMode.h"
+
+void ULevelSnapshotSubsystem::Deinitialize()
+{
+	actors.Empty();
+	generators.Empty();
+	snapshotData.Empty();
+	Super::Deinitialize();
+}
+
+void ULevelSnapshotSubsystem::RequestCapture()
+{
+	GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &ULevelSnapshotSubsystem::CaptureSnapshot));
+}
+
+void ULevelSnapshotSubsystem::CaptureSnapshot()
+{
+	actors.Reset();
+	generators.Reset();
+	snapshotData.Reset();
+	captureTime = GetWorld()->GetTimeSeconds();
+
+	// El modo por rondas tiene estado propio (ronda, objetivos del pool, campo instanciado, cohortes del timing wheel)
+	// que el snapshot no guarda. Sin snapshot, Retry recarga el mapa
+	if (Cast<ADualCombatColor_GameMode>(GetWorld()->GetAuthGameMode()) != nullptr)
+	{
+		return;
+	}
+
+	// Se recorre el mundo una sola vez al empezar el nivel
+	for (TActorIterator<AActor> it(GetWorld()); it; ++it)
+	{
+		AActor* actor = *it;
+		FSnapshotActor snapshotActor;
+		snapshotActor.actor = actor;
+		if (AEndlessParkourGenerator* generator = Cast<AEndlessParkourGenerator>(actor))
+		{
+			generators.Add(generator);
+			continue;
+		}
+		// Las plataformas del generador se reciclan y reaparecen en otro lugar, las rearma el generador
+		if (actor->IsA<APlatformPawn>() && Cast<AEndlessParkourGenerator>(actor->GetOwner()) != nullptr)
+		{
+			continue;
+		}
+		if (actor->IsA<APlatformPawn>())
+		{
+			snapshotActor.kind = ESnapshotActorKind::Platform;
+		}
+		else if (actor->IsA<AActorObstacleRay>())
+		{
+			snapshotActor.kind = ESnapshotActorKind::Ray;
+		}
+		else if (actor->IsA<ADualCombatColor_FPSCharacter>())
+		{
+			snapshotActor.kind = ESnapshotActorKind::Player;
+		}
+		else
+		{
+			continue;
+		}
+		actors.Add(snapshotActor);
+	}
+
+	FMemoryWriter writer(snapshotData);
+	for (const FSnapshotActor& snapshotActor : actors)
+	{
+		SerializeActor(writer, snapshotActor.actor.Get(), snapshotActor.kind);
+	}
+}
+
+bool ULevelSnapshotSubsystem::RestoreSnapshot()
+{
+	if (!HasSnapshot())
+	{
+		return false;
+	}
+
+	UProjectilePoolSubsystem* projectilePool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	if (projectilePool != nullptr)
+	{
+		projectilePool->ReleaseAllProjectiles();
+	}
+	UBulkProjectileSubsystem* bulkProjectiles = GetWorld()->GetSubsystem<UBulkProjectileSubsystem>();
+	if (bulkProjectiles != nullptr)
+	{
+		bulkProjectiles->ClearProjectiles();
+	}
+
+	// Los actores destruidos desde la captura igual se leen, para no desalinear el archivo
+	FMemoryReader reader(snapshotData);
+	for (const FSnapshotActor& snapshotActor : actors)
+	{
+		SerializeActor(reader, snapshotActor.actor.Get(), snapshotActor.kind);
+	}
+
+	for (const TWeakObjectPtr<AEndlessParkourGenerator>& generator : generators)
+	{
+		if (generator.IsValid())
+		{
+			generator->ResetToStart();
+		}
+	}
+
+	// Las plataformas que mueve el subsistema vuelven a la fase que tenian al capturar
+	const float time = GetWorld()->GetTimeSeconds();
+	UPlatformMotionSubsystem* platformMotion = GetWorld()->GetSubsystem<UPlatformMotionSubsystem>();
+	if (platformMotion != nullptr)
+	{
+		platformMotion->RewindMotion(time - captureTime);
+	}
+	// Desde aca el mundo vuelve a estar como al capturar, el proximo retry se mide desde ahora
+	captureTime = time;
+	return true;
+}
+
+void ULevelSnapshotSubsystem::SerializeActor(FArchive& archive, AActor* actor, ESnapshotActorKind kind)
+{
+	const bool bLoading = archive.IsLoading();
+
+	FTransform transform = (!bLoading && actor != nullptr) ? actor->GetActorTransform() : FTransform::Identity;
+	archive << transform;
+	if (bLoading && actor != nullptr)
+	{
+		// El transform de una plataforma en movimiento lo pone el subsistema en su proximo tick
+		UPlatformMotionSubsystem* platformMotion = GetWorld()->GetSubsystem<UPlatformMotionSubsystem>();
+		if (platformMotion == nullptr || !platformMotion->IsPlatformDriven(actor))
+		{
+			actor->SetActorTransform(transform, false, nullptr, ETeleportType::ResetPhysics);
+		}
+	}
+
+	switch (kind)
+	{
+	case ESnapshotActorKind::Platform:
+	{
+		APlatformPawn* platform = Cast<APlatformPawn>(actor);
+		bool bIsTread = platform != nullptr && platform->bIsTread;
+		bool bHidden = platform != nullptr && platform->IsHidden();
+		bool bCollision = platform != nullptr && platform->GetActorEnableCollision();
+		archive << bIsTread;
+		archive << bHidden;
+		archive << bCollision;
+		if (bLoading && platform != nullptr)
+		{
+			platform->bIsTread = bIsTread;
+			platform->SetActorHiddenInGame(bHidden);
+			platform->SetActorEnableCollision(bCollision);
+		}
+		break;
+	}
+	case ESnapshotActorKind::Ray:
+	{
+		AActorObstacleRay* ray = Cast<AActorObstacleRay>(actor);
+		bool bRayActive = ray != nullptr && ray->IsRayActive();
+		archive << bRayActive;
+		if (bLoading && ray != nullptr)
+		{
+			if (bRayActive)
+			{
+				ray->ActivateRay();
+			}
+			else
+			{
+				ray->DeactivateRay();
+			}
+		}
+		break;
+	}
+	case ESnapshotActorKind::Player:
+	{
+		ADualCombatColor_FPSCharacter* player = Cast<ADualCombatColor_FPSCharacter>(actor);
+		FRotator controlRotation = (player != nullptr) ? player->GetControlRotation() : FRotator::ZeroRotator;
+		FDataPlayer dataPlayer = (player != nullptr) ? player->FdataPlayer : FDataPlayer();
+		archive << controlRotation;
+		archive << dataPlayer.score;
+		archive << dataPlayer.numberCurrentLevel;
+		archive << dataPlayer.life;
+		if (bLoading && player != nullptr)
+		{
+			player->FdataPlayer = dataPlayer;
+			player->OnLevelRestored(controlRotation);
+
+			UCheckpointSubsystem* checkpoints = GetWorld()->GetSubsystem<UCheckpointSubsystem>();
+			if (checkpoints != nullptr)
+			{
+				checkpoints->SetCheckpoint(transform, dataPlayer.score);
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
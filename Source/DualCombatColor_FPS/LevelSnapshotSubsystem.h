@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LevelSnapshotSubsystem.generated.h"
+
+class AEndlessParkourGenerator;
+
+enum class ESnapshotActorKind : uint8
+{
+	Platform,
+	Ray,
+	Player,
+	Other
+};
+
+struct FSnapshotActor
+{
+	TWeakObjectPtr<AActor> actor;
+	ESnapshotActorKind kind;
+};
+
+/**
+ * Saves the gameplay state of the level right after it starts into a memory archive:
+ * transforms, tread platforms, which rays are on and the player's data. Retry restores it
+ * in one frame instead of reloading the map. Projectiles in flight are put back in their
+ * pools. Platforms of an endless generator are not captured, the generator starts again
+ * from its seed instead, and platforms moved by the motion subsystem get their motion
+ * rewound rather than their transform.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API ULevelSnapshotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Captures the snapshot on the next tick, once every actor of the level has begun play. */
+	void RequestCapture();
+
+	void CaptureSnapshot();
+
+	/**
+	 * Puts every captured actor back to its captured state. Returns false if there is no snapshot,
+	 * which is always the case in round based ADualCombatColor_GameMode maps.
+	 */
+	bool RestoreSnapshot();
+
+	FORCEINLINE bool HasSnapshot() const { return snapshotData.Num() > 0; }
+
+private:
+	/** Writes the actor state when the archive is saving and applies it when loading. actor can be null when loading. */
+	void SerializeActor(FArchive& archive, AActor* actor, ESnapshotActorKind kind);
+
+	TArray<FSnapshotActor> actors;
+	TArray<TWeakObjectPtr<AEndlessParkourGenerator>> generators;
+	TArray<uint8> snapshotData;
+
+	/** World time the captured state belongs to. */
+	float captureTime = 0.0f;
+};
@@ -3,3 +3,13 @@
 
 #include "LoadDataAsset.h"
 
+// Tiene que coincidir con PrimaryAssetTypesToScan en DefaultGame.ini
+const FPrimaryAssetType ULoadDataAsset::PrimaryAssetType = TEXT("LoadDataAsset");
+
+const FName ULoadDataAsset::MenuBundle = TEXT("Menu");
+const FName ULoadDataAsset::GameplayBundle = TEXT("Gameplay");
+
+FPrimaryAssetId ULoadDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
@@ -20,16 +20,30 @@ struct FSkinVisualData
 	UPROPERTY(EditDefaultsOnly)
 		TSoftObjectPtr<class USkeletalMesh> SkeletalMeshPtr;
 };
+
+/**
+ * Skin registered with the asset manager as a primary asset. Its soft references are tagged
+ * with the bundles that need them, so the menu and gameplay data can be loaded and unloaded
+ * separately with UAssetStreamingSubsystem::PreloadBundles.
+ */
 UCLASS()
-class DUALCOMBATCOLOR_FPS_API ULoadDataAsset : public UDataAsset
+class DUALCOMBATCOLOR_FPS_API ULoadDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
-	
+public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	static const FName MenuBundle;
+	static const FName GameplayBundle;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
 protected:
 	UPROPERTY(EditDefaultsOnly)
 		FString Name;
 
-	UPROPERTY(EditDefaultsOnly)
+	/** The menus preview the same mesh and materials the skin uses in game. */
+	UPROPERTY(EditDefaultsOnly, meta = (AssetBundles = "Menu,Gameplay"))
 		FSkinVisualData VisualData;
 
 	UPROPERTY(EditDefaultsOnly)
@@ -2,9 +2,19 @@
 
 
 #include "MenuHUD.h"
+#include "Engine/GameInstance.h"
+#include "AssetStreamingSubsystem.h"
+#include "LoadDataAsset.h"
 
 void AMenuHUD::BeginPlay()
 {
+	Super::BeginPlay();
+	// Solo se cargan los bundles del menu, los de juego se piden al entrar al nivel
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming != nullptr)
+	{
+		bundleRequestId = streaming->PreloadBundles(ULoadDataAsset::PrimaryAssetType, menuBundles, FOnAssetRequestComplete());
+	}
 	APlayerController* playerController = Cast<APlayerController>(GetOwner());
 	if(MenuWidgetClass == nullptr)
 	{
@@ -17,3 +27,13 @@ void AMenuHUD::BeginPlay()
 		//UE_LOG(LogTemp, Warning, TEXT("CREE EL MENU WIDGET PAPA"));
 	}
 }
+
+void AMenuHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming != nullptr)
+	{
+		streaming->ReleaseRequest(bundleRequestId);
+	}
+	Super::EndPlay(EndPlayReason);
+}
@@ -24,4 +24,12 @@ protected:
 		UMainMenuWidget* MenuWidget;
 
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Bundles of the LoadDataAsset skins preloaded while the menu is open. */
+	UPROPERTY(EditDefaultsOnly)
+		TArray<FName> menuBundles = { TEXT("Menu") };
+
+	int32 bundleRequestId = INDEX_NONE;
 };
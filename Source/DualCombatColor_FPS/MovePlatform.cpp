@@ -1,10 +1,11 @@
 #include "MovePlatform.h"
+#include "Engine/World.h"
 
 // Sets default values
 AMovePlatform::AMovePlatform()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// El movimiento lo hace UPlatformMotionSubsystem, las plataformas no tickean
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 // Called when the game starts or when spawned
@@ -19,39 +20,29 @@ void AMovePlatform::BeginPlay()
     maxHeight = 20.0f;
     maxHorizontal = 20.0f;
     rotationDegrees = 20.0f;
-	
-}
-
-// Called every frame
-void AMovePlatform::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-    FVector NewLocation = GetActorLocation();
-    FRotator NewRotation = GetActorRotation();
 
-    float RunningTime = GetGameTimeSinceCreation();
-
-    if (canMoveHorizontal) 
-    {
-        float DeltaHorizontal = (FMath::Sin(RunningTime + DeltaTime) - FMath::Sin(RunningTime));
-        NewLocation.X += DeltaHorizontal * maxHorizontal;
-    }
-    
-    if (canMoveVertical)
+    UPlatformMotionSubsystem* motionSubsystem = GetWorld()->GetSubsystem<UPlatformMotionSubsystem>();
+    if (motionSubsystem != nullptr)
     {
-        float DeltaHeight = (FMath::Sin(RunningTime + DeltaTime) - FMath::Sin(RunningTime));
-        NewLocation.Z += DeltaHeight * maxHeight;
+        motionSubsystem->RegisterPlatform(this, GetMotionParams());
     }
-    
-    if (canRotate)
+}
+
+void AMovePlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UPlatformMotionSubsystem* motionSubsystem = GetWorld()->GetSubsystem<UPlatformMotionSubsystem>();
+    if (motionSubsystem != nullptr)
     {
-        float DeltaRotation = DeltaTime * rotationDegrees;
-        NewRotation.Yaw += DeltaRotation;
+        motionSubsystem->UnregisterPlatform(this);
     }
-
-    SetActorLocationAndRotation(NewLocation, NewRotation);
+    Super::EndPlay(EndPlayReason);
 }
 
-
-
+FPlatformMotionParams AMovePlatform::GetMotionParams() const
+{
+    FPlatformMotionParams params;
+    params.horizontalAmplitude = canMoveHorizontal ? maxHorizontal : 0.0f;
+    params.verticalAmplitude = canMoveVertical ? maxHeight : 0.0f;
+    params.yawSpeed = canRotate ? rotationDegrees : 0.0f;
+    return params;
+}
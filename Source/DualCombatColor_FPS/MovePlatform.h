@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "PlatformMotionSubsystem.h"
 #include "MovePlatform.generated.h"
 
 UCLASS()
@@ -35,8 +36,10 @@ protected:
     // Called when the game starts or when spawned
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:
-    // Called every frame
-    virtual void Tick(float DeltaTime) override;
+    /** Motion handed to UPlatformMotionSubsystem, which moves the platform instead of Tick. */
+    FPlatformMotionParams GetMotionParams() const;
 
 };
@@ -3,6 +3,8 @@
 
 #include "ParkourGameInstance.h"
 #include "AssetLoaderManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
 
 UParkourGameInstance::UParkourGameInstance()
 {
@@ -10,6 +12,33 @@ UParkourGameInstance::UParkourGameInstance()
 	currentData.currentLevel = 1;
 }
 
+void UParkourGameInstance::Init()
+{
+	Super::Init();
+
+	// La GameInstance nativa se usa directo desde DefaultEngine.ini, el catalogo sale de la configuracion
+	loadedLevelCatalog = levelCatalog.LoadSynchronous();
+	if (loadedLevelCatalog == nullptr)
+	{
+		if (!levelCatalog.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No se encontro el catalogo de niveles %s, se usa defaultLevels"), *levelCatalog.ToString());
+		}
+		loadedLevelCatalog = NewObject<ULevelCatalog>(this);
+		loadedLevelCatalog->levels = defaultLevels;
+	}
+	postLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UParkourGameInstance::OnPostLoadMap);
+}
+
+void UParkourGameInstance::Shutdown()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(postLoadMapHandle);
+	preloadedLevels.Empty();
+	pendingPreloads.Empty();
+	loadedLevelCatalog = nullptr;
+	Super::Shutdown();
+}
+
 void UParkourGameInstance::SetAssetLoaderInstance(AAssetLoaderManager* NewManager)
 {
 	AssetLoaderManager = NewManager;
@@ -19,3 +48,74 @@ AAssetLoaderManager* UParkourGameInstance::GetAssetLoaderManagerInstance()
 {
 	return AssetLoaderManager;
 }
+
+const FLevelCatalogEntry* UParkourGameInstance::GetNextLevelEntry() const
+{
+	if (loadedLevelCatalog == nullptr || GetWorld() == nullptr)
+	{
+		return nullptr;
+	}
+	// Sin el prefijo de PIE para que coincida con el nombre del asset
+	return loadedLevelCatalog->FindNextLevel(UGameplayStatics::GetCurrentLevelName(GetWorld(), true));
+}
+
+void UParkourGameInstance::PreloadLevel(const TSoftObjectPtr<UWorld>& level)
+{
+	const FName packageName(*level.GetLongPackageName());
+	if (packageName.IsNone() || preloadedLevels.Contains(packageName) || pendingPreloads.Contains(packageName))
+	{
+		return;
+	}
+	pendingPreloads.Add(packageName);
+	LoadPackageAsync(packageName.ToString(), FLoadPackageAsyncDelegate::CreateUObject(this, &UParkourGameInstance::OnLevelPreloaded));
+}
+
+bool UParkourGameInstance::IsLevelPreloaded(const TSoftObjectPtr<UWorld>& level) const
+{
+	return preloadedLevels.Contains(FName(*level.GetLongPackageName()));
+}
+
+void UParkourGameInstance::OnLevelPreloaded(const FName& packageName, UPackage* package, EAsyncLoadingResult::Type result)
+{
+	if (pendingPreloads.Remove(packageName) == 0)
+	{
+		// Se cambio de mapa antes de terminar la carga
+		return;
+	}
+	if (result != EAsyncLoadingResult::Succeeded || package == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No se pudo precargar el nivel %s"), *packageName.ToString());
+		return;
+	}
+	preloadedLevels.Add(packageName, package);
+}
+
+void UParkourGameInstance::TravelToLevel(const FLevelCatalogEntry& entry)
+{
+	UWorld* world = GetWorld();
+	const FString levelPath = entry.level.GetLongPackageName();
+	if (world == nullptr || levelPath.IsEmpty())
+	{
+		return;
+	}
+	if (!IsLevelPreloaded(entry.level))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("El nivel %s no termino de precargarse, se carga bloqueando"), *levelPath);
+	}
+	// currentData vive en la GameInstance, sobrevive a los dos tipos de viaje
+	if (entry.bSeamlessTravel)
+	{
+		world->SeamlessTravel(levelPath, true);
+	}
+	else
+	{
+		UGameplayStatics::OpenLevel(world, FName(*levelPath));
+	}
+}
+
+void UParkourGameInstance::OnPostLoadMap(UWorld* world)
+{
+	// El mundo nuevo ya tiene su paquete, las precargas anteriores se sueltan
+	preloadedLevels.Empty();
+	pendingPreloads.Empty();
+}
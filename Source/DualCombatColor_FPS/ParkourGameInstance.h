@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
+#include "UObject/UObjectGlobals.h"
+#include "LevelCatalog.h"
 #include "ParkourGameInstance.generated.h"
 
 USTRUCT()
@@ -23,19 +25,55 @@ class AAssetLoaderManager;
 /**
  * 
  */
-UCLASS()
+UCLASS(config=Game)
 class DUALCOMBATCOLOR_FPS_API UParkourGameInstance : public UGameInstance
 {
 	GENERATED_BODY()
 public:
 	UParkourGameInstance();
 
+	virtual void Init() override;
+	virtual void Shutdown() override;
+
 	UPROPERTY()
 		FCurrentData currentData;
+
+	/** Catalog asset with the chain of maps. If it is not set the chain is built from defaultLevels. */
+	UPROPERTY(Config)
+		TSoftObjectPtr<ULevelCatalog> levelCatalog;
+
+	/** Chain of maps used when no catalog asset is set. */
+	UPROPERTY(Config)
+		TArray<FLevelCatalogEntry> defaultLevels;
+
+	/** Catalog entry of the map after the current one, or nullptr. */
+	const FLevelCatalogEntry* GetNextLevelEntry() const;
+
+	/** Starts loading the package of the map in the background. The package is kept alive until the next map is entered. */
+	void PreloadLevel(const TSoftObjectPtr<UWorld>& level);
+
+	bool IsLevelPreloaded(const TSoftObjectPtr<UWorld>& level) const;
+
+	/** Travels to the entry, using the preloaded package if it finished loading. */
+	void TravelToLevel(const FLevelCatalogEntry& entry);
 	
 	void SetAssetLoaderInstance(AAssetLoaderManager* NewManager);
 	AAssetLoaderManager* GetAssetLoaderManagerInstance();
 private:
 	UPROPERTY()
 		AAssetLoaderManager* AssetLoaderManager = nullptr;
+
+	UPROPERTY()
+		ULevelCatalog* loadedLevelCatalog = nullptr;
+
+	void OnLevelPreloaded(const FName& packageName, UPackage* package, EAsyncLoadingResult::Type result);
+	void OnPostLoadMap(UWorld* world);
+
+	// Referencias a los mapas precargados, sin ellas el GC los descargaria antes del viaje
+	UPROPERTY()
+		TMap<FName, UPackage*> preloadedLevels;
+
+	TSet<FName> pendingPreloads;
+
+	FDelegateHandle postLoadMapHandle;
 };
@@ -1,45 +1,190 @@
 #include "Parkour_GameMode.h"
 #include "Engine/World.h"
+#include "Engine/GameInstance.h"
 #include "PlatformPawn.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Actor.h"
-#include "AssetLoaderManager.h"
+#include "TimerManager.h"
+#include "Async/Async.h"
+#include "PlatformRegistrySubsystem.h"
+#include "AssetStreamingSubsystem.h"
+#include "LoadDataAsset.h"
 AParkour_GameMode::AParkour_GameMode() 
 {
+	PrimaryActorTick.bCanEverTick = true;
 }
 void AParkour_GameMode::Tick(float DeltaTime)
 {
+	Super::Tick(DeltaTime);
+
+	if (trapPlacementFuture.IsValid() && trapPlacementFuture.IsReady())
+	{
+		placedTraps = trapPlacementFuture.Get();
+		trapPlacementFuture = TFuture<TArray<FTrapPlacement>>();
+		nextTrapToSpawn = 0;
+	}
+	if (nextTrapToSpawn < placedTraps.Num())
+	{
+		SpawnPlacedTraps();
+	}
 }
 
 void AParkour_GameMode::BeginPlay()
 {
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), platformPawn_Class, actorPlatforms);
-	for (AActor* actor : actorPlatforms)
+	Super::BeginPlay();
+	// Las plataformas se registran solas en UPlatformRegistrySubsystem, no hace falta recorrer el mundo.
+	// Se espera un frame para que todas las plataformas del nivel ya hayan hecho su BeginPlay
+	if (trap != nullptr)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &AParkour_GameMode::StartTrapPlacement);
+	}
+	// Los assets que piden los actores del nivel los carga UAssetStreamingSubsystem en lotes al siguiente tick
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming != nullptr)
+	{
+		// No es persistente, se descarga en PreLoadMap al salir del nivel
+		streaming->PreloadBundles(ULoadDataAsset::PrimaryAssetType, gameplayBundles, FOnAssetRequestComplete());
+	}
+}
+
+void AParkour_GameMode::StartTrapPlacement()
+{
+	UPlatformRegistrySubsystem* platformRegistry = GetWorld()->GetSubsystem<UPlatformRegistrySubsystem>();
+	if (platformRegistry == nullptr)
+	{
+		return;
+	}
+	TArray<APlatformPawn*> platforms;
+	platformRegistry->GetAllPlatforms(platforms);
+
+	TArray<FTrapPlatformSnapshot> snapshot;
+	snapshot.Reserve(platforms.Num());
+	for (APlatformPawn* platform : platforms)
 	{
-		if (actor != nullptr)
+		if (platformPawn_Class != nullptr && !platform->IsA(platformPawn_Class))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Hola Actors:D"));
-			refPlatforms.Add(Cast<APlatformPawn>(actor));
+			continue;
 		}
+		FTrapPlatformSnapshot platformSnapshot;
+		platformSnapshot.platformId = platform->GetPlatformId();
+		platformSnapshot.transform = platform->GetActorTransform();
+		platformSnapshot.length = platform->length;
+		platformSnapshot.wight = platform->wight;
+		snapshot.Add(platformSnapshot);
 	}
-	for (APlatformPawn* refplatform : refPlatforms)
+
+	FTrapPlacementSettings settings;
+	settings.seed = trapSeed != 0 ? trapSeed : FMath::Rand();
+	settings.density = trapDensity;
+	settings.minSpacing = minTrapSpacing;
+	settings.heightOffset = trapHeightOffset;
+	settings.attemptsPerPlatform = 4;
+
+	// El hilo solo recibe copias, el game mode puede destruirse antes de que termine
+	trapPlacementFuture = Async(EAsyncExecution::ThreadPool, [snapshot = MoveTemp(snapshot), settings]()
+	{
+		return PlaceTraps(snapshot, settings);
+	});
+}
+
+TArray<FTrapPlacement> AParkour_GameMode::PlaceTraps(const TArray<FTrapPlatformSnapshot>& platforms, const FTrapPlacementSettings& settings)
+{
+	// Ordenadas por id para que la misma semilla de siempre el mismo resultado
+	TArray<FTrapPlatformSnapshot> sortedPlatforms = platforms;
+	sortedPlatforms.Sort([](const FTrapPlatformSnapshot& a, const FTrapPlatformSnapshot& b) { return a.platformId < b.platformId; });
+
+	FRandomStream randomStream(settings.seed);
+	const float cellSize = FMath::Max(settings.minSpacing, 1.0f);
+	const float minSpacingSquared = settings.minSpacing * settings.minSpacing;
+	TMap<FIntVector, TArray<int32>> spatialHash;
+	TArray<FTrapPlacement> traps;
+
+	for (const FTrapPlatformSnapshot& platform : sortedPlatforms)
 	{
-		if (refplatform != nullptr)
+		if (randomStream.FRand() >= settings.density)
+		{
+			continue;
+		}
+		for (int32 attempt = 0; attempt < settings.attemptsPerPlatform; attempt++)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Hola Platforms :D"));
-			FVector position = GetRandomPosition(refplatform->length, refplatform->wight, refplatform->GetActorTransform().GetLocation().Z + 10);
-			FRotator rotator = refplatform->GetActorRotation();
-			//Spawning objects
+			const FVector localPosition = GetRandomPosition(randomStream, platform.length, platform.wight, 0.0f);
+			const FVector location = platform.transform.TransformPosition(localPosition) + FVector(0.0f, 0.0f, settings.heightOffset);
+			const FIntVector cell(FMath::FloorToInt(location.X / cellSize), FMath::FloorToInt(location.Y / cellSize), FMath::FloorToInt(location.Z / cellSize));
+
+			// Con celdas del tamano de la separacion alcanza con revisar las vecinas
+			bool bTooClose = false;
+			for (int32 z = -1; z <= 1 && !bTooClose; z++)
+			{
+				for (int32 y = -1; y <= 1 && !bTooClose; y++)
+				{
+					for (int32 x = -1; x <= 1 && !bTooClose; x++)
+					{
+						const TArray<int32>* cellTraps = spatialHash.Find(cell + FIntVector(x, y, z));
+						if (cellTraps == nullptr)
+						{
+							continue;
+						}
+						for (int32 trapIndex : *cellTraps)
+						{
+							if (FVector::DistSquared(traps[trapIndex].location, location) < minSpacingSquared)
+							{
+								bTooClose = true;
+								break;
+							}
+						}
+					}
+				}
+			}
+			if (bTooClose)
+			{
+				continue;
+			}
+
+			FTrapPlacement placement;
+			placement.platformId = platform.platformId;
+			placement.location = location;
+			placement.localLocation = localPosition;
+			spatialHash.FindOrAdd(cell).Add(traps.Add(placement));
+			break;
+		}
+	}
+	return traps;
+}
 
+void AParkour_GameMode::SpawnPlacedTraps()
+{
+	UPlatformRegistrySubsystem* platformRegistry = GetWorld()->GetSubsystem<UPlatformRegistrySubsystem>();
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	const int32 lastTrap = FMath::Min(nextTrapToSpawn + maxTrapSpawnsPerFrame, placedTraps.Num());
+	for (; nextTrapToSpawn < lastTrap; nextTrapToSpawn++)
+	{
+		const FTrapPlacement& placement = placedTraps[nextTrapToSpawn];
+		APlatformPawn* platform = platformRegistry != nullptr ? platformRegistry->GetPlatform(placement.platformId) : nullptr;
+		if (platform == nullptr)
+		{
+			// La plataforma se destruyo mientras se calculaban las posiciones
+			continue;
+		}
+		const FTransform& platformTransform = platform->GetActorTransform();
+		const FVector location = platformTransform.TransformPosition(placement.localLocation) + FVector(0.0f, 0.0f, trapHeightOffset);
+		APawn* spawnedTrap = GetWorld()->SpawnActor<APawn>(trap, location, platformTransform.Rotator(), spawnParams);
+		if (spawnedTrap != nullptr)
+		{
+			// La trampa sigue a la plataforma si esta se mueve
+			spawnedTrap->AttachToActor(platform, FAttachmentTransformRules::KeepWorldTransform);
+			spawnedTraps.Add(spawnedTrap);
 		}
 	}
-	//Carga El Asset de forma Asyncronica//
-	AAssetLoaderManager* AssetLoader = Cast<AAssetLoaderManager>(AAssetLoaderManager::StaticClass()->GetDefaultObject());
-	AssetLoader->LoadAssets();
-	GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green, TEXT("AssetLoadStart"));
-	//----------------------------------//
+	if (nextTrapToSpawn >= placedTraps.Num())
+	{
+		placedTraps.Reset();
+		nextTrapToSpawn = 0;
+	}
 }
-FVector AParkour_GameMode::GetRandomPosition(float maxLength, float maxWight, float hight)
+
+FVector AParkour_GameMode::GetRandomPosition(FRandomStream& randomStream, float maxLength, float maxWight, float hight)
 {
-	return FVector(FMath::RandRange(-maxLength, maxLength), hight, FMath::RandRange(-maxWight, maxWight));
-}
\ No newline at end of file
+	return FVector(randomStream.FRandRange(-maxLength, maxLength), randomStream.FRandRange(-maxWight, maxWight), hight);
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameMode.h"
+#include "Async/Future.h"
 #include "Parkour_GameMode.generated.h"
 
 /**
@@ -12,6 +13,34 @@
 
 class APlatformPawn;
 class AActor;
+
+/** Copy of the platform data the trap placement needs, safe to read from a worker thread. */
+struct FTrapPlatformSnapshot
+{
+	int32 platformId;
+	FTransform transform;
+	float length;
+	float wight;
+};
+
+struct FTrapPlacementSettings
+{
+	int32 seed;
+	float density;
+	float minSpacing;
+	float heightOffset;
+	int32 attemptsPerPlatform;
+};
+
+struct FTrapPlacement
+{
+	int32 platformId;
+	/** Location in the platform snapshot, used for the spacing rule. */
+	FVector location;
+	/** Location in platform space, so moving platforms get the trap where they are when it spawns. */
+	FVector localLocation;
+};
+
 UCLASS()
 class DUALCOMBATCOLOR_FPS_API AParkour_GameMode : public AGameMode
 {
@@ -26,15 +55,50 @@ public:
 	UPROPERTY(EditAnywhere)
 		TSubclassOf<APlatformPawn> platformPawn_Class;
 
+	/** Bundles of the LoadDataAsset skins loaded for this level. They are unloaded when the level is left. */
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+		TArray<FName> gameplayBundles = { TEXT("Gameplay") };
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 		TSubclassOf<APawn> trap;
-	
-	FVector GetRandomPosition(float maxLength, float maxWight, float hight);
-	
-	UPROPERTY()
-		TArray<AActor*> actorPlatforms;
 
-	UPROPERTY(EditAnywhere)
-		TArray<APlatformPawn*> refPlatforms;
-};
+	/** Chance of each platform getting a trap. */
+	UPROPERTY(EditAnywhere, Category = "Traps", meta = (ClampMin = "0", ClampMax = "1"))
+		float trapDensity = 0.25f;
+
+	/** Minimum distance between two traps. */
+	UPROPERTY(EditAnywhere, Category = "Traps")
+		float minTrapSpacing = 300.0f;
+
+	/** Height of the traps over the platform origin. */
+	UPROPERTY(EditAnywhere, Category = "Traps")
+		float trapHeightOffset = 10.0f;
+
+	/** Seed of the trap placement. 0 picks a different seed every time the level starts. */
+	UPROPERTY(EditAnywhere, Category = "Traps")
+		int32 trapSeed = 0;
+
+	/** Maximum traps spawned in one frame once placement is done. */
+	UPROPERTY(EditAnywhere, Category = "Traps")
+		int32 maxTrapSpawnsPerFrame = 8;
+
+	/** Random point on a platform of the given half size, in platform space. */
+	static FVector GetRandomPosition(FRandomStream& randomStream, float maxLength, float maxWight, float hight);
 
+	/** Picks the trap positions. Only touches its arguments, so it runs on a worker thread. */
+	static TArray<FTrapPlacement> PlaceTraps(const TArray<FTrapPlatformSnapshot>& platforms, const FTrapPlacementSettings& settings);
+
+private:
+	/** Takes a snapshot of the registered platforms and starts the placement on the thread pool. */
+	void StartTrapPlacement();
+
+	/** Spawns the placed traps until the frame budget runs out. */
+	void SpawnPlacedTraps();
+
+	TFuture<TArray<FTrapPlacement>> trapPlacementFuture;
+	TArray<FTrapPlacement> placedTraps;
+	int32 nextTrapToSpawn = 0;
+
+	UPROPERTY()
+		TArray<APawn*> spawnedTraps;
+};
@@ -10,21 +10,27 @@
 void UPauseMenuWidget::NativeOnInitialized()
 {
 	Super::NativeOnInitialized();
-	//CanvasPauseMenu->SetVisibility(ESlateVisibility::Hidden);
+	//CanvasPauseMenu->SetVisibility(ESlateVisibility::Collapsed);
+}
+
+void UPauseMenuWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
 
+	// El widget vive en la GameInstance y se vuelve a construir en cada mapa, los botones se enlazan aca porque NativeDestruct los suelta
 	if (ButtonResume != nullptr)
 	{
-		ButtonResume->OnClicked.AddDynamic(this, &ThisClass::OnClikedButtonResume);
+		ButtonResume->OnClicked.AddUniqueDynamic(this, &ThisClass::OnClikedButtonResume);
 		//UE_LOG(LogTemp, Warning, TEXT("Boton seteado"));
 	}
 	if (BackToMenu != nullptr)
 	{
-		BackToMenu->OnClicked.AddDynamic(this, &ThisClass::OnClikedButtonBackToMenu);
+		BackToMenu->OnClicked.AddUniqueDynamic(this, &ThisClass::OnClikedButtonBackToMenu);
 		//UE_LOG(LogTemp, Warning, TEXT("Boton seteado"));
 	}
 	if (ButtonExit != nullptr)
 	{
-		ButtonExit->OnClicked.AddDynamic(this, &ThisClass::OnClikedButtonExit);
+		ButtonExit->OnClicked.AddUniqueDynamic(this, &ThisClass::OnClikedButtonExit);
 		//UE_LOG(LogTemp, Warning, TEXT("Boton seteado"));
 	}
 }
@@ -44,7 +50,7 @@ void UPauseMenuWidget::DeactivateMe()
 	{
 		UGameplayStatics::SetGamePaused(GetWorld(), false);
 		//UE_LOG(LogTemp, Warning, TEXT("DeactivateMe"));
-		CanvasPauseMenu->SetVisibility(ESlateVisibility::Hidden);
+		CanvasPauseMenu->SetVisibility(ESlateVisibility::Collapsed);
 	}
 }
 
@@ -32,6 +32,7 @@ protected:
 
 public:
 	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
 	
 	void ActivateMe();
@@ -3,6 +3,8 @@
 
 #include "PawnObjectDestructibleTarget.h"
 #include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "SignificanceTickSubsystem.h"
 
 // Sets default values
 APawnObjectDestructibleTarget::APawnObjectDestructibleTarget()
@@ -16,7 +18,18 @@ APawnObjectDestructibleTarget::APawnObjectDestructibleTarget()
 void APawnObjectDestructibleTarget::BeginPlay()
 {
 	Super::BeginPlay();
-	
+	// Se guarda antes de que la fisica mueva los componentes, para poder resetearlos al reciclar el objetivo
+	CachePhysicsComponents();
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->RegisterActor(this);
+	}
+}
+
+EGameplayRole APawnObjectDestructibleTarget::GetGameplayRoles() const
+{
+	return EGameplayRole::Target | IGameplayRoleActor::GetRolesFromTags(this);
 }
 
 // Called every frame
@@ -26,10 +39,29 @@ void APawnObjectDestructibleTarget::Tick(float DeltaTime)
 
 }
 
-void APawnObjectDestructibleTarget::StartTimeLife()
+void APawnObjectDestructibleTarget::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		timingWheel->ClearTimer(lifeTimerHandle);
+	}
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->UnregisterActor(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void APawnObjectDestructibleTarget::StartTimeLife(int32 cohort)
 {
-	FTimerHandle UnsedHandle;
-	GetWorldTimerManager().SetTimer(UnsedHandle, this, &APawnObjectDestructibleTarget::CheckLife, timeLife, false);
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		timingWheel->ClearTimer(lifeTimerHandle);
+		lifeTimerHandle = timingWheel->SetTimer(this, &APawnObjectDestructibleTarget::CheckLife, timeLife, false, cohort);
+	}
 }
 // Called to bind functionality to input
 void APawnObjectDestructibleTarget::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -40,8 +72,110 @@ void APawnObjectDestructibleTarget::SetupPlayerInputComponent(UInputComponent* P
 void APawnObjectDestructibleTarget::CheckLife()
 {
 	if (bDestroyForTime)
+	{
+		DestroyTarget();
+	}
+}
+
+void APawnObjectDestructibleTarget::FellOutOfWorld(const UDamageType& dmgType)
+{
+	if (OnTargetReleased.IsBound())
+	{
+		DestroyTarget();
+	}
+	else
+	{
+		Super::FellOutOfWorld(dmgType);
+	}
+}
+
+void APawnObjectDestructibleTarget::DestroyTarget()
+{
+	if (!OnTargetReleased.IsBound())
 	{
 		Destroy();
+		return;
+	}
+	if (bTargetActive)
+	{
+		DeactivateTarget();
+		OnTargetReleased.Execute(this);
+	}
+}
+
+void APawnObjectDestructibleTarget::CachePhysicsComponents()
+{
+	if (physicsComponents.Num() > 0 || RootComponent == nullptr)
+	{
+		return;
+	}
+	TInlineComponentArray<UPrimitiveComponent*> primitiveComponents(this);
+	for (UPrimitiveComponent* component : primitiveComponents)
+	{
+		if (component->IsSimulatingPhysics())
+		{
+			physicsComponents.Add(component);
+			physicsComponentsRelativeTransforms.Add(component == RootComponent ? FTransform::Identity : component->GetComponentTransform().GetRelativeTransform(RootComponent->GetComponentTransform()));
+		}
+	}
+}
+
+void APawnObjectDestructibleTarget::ActivateTarget(const FVector& location, const FRotator& rotation)
+{
+	SetActorLocationAndRotation(location, rotation, false, nullptr, ETeleportType::ResetPhysics);
+	for (int32 i = 0; i < physicsComponents.Num(); i++)
+	{
+		UPrimitiveComponent* component = physicsComponents[i];
+		if (component == nullptr)
+		{
+			continue;
+		}
+		// Al simular fisica un componente hijo se suelta del root, se vuelve a poner donde estaba
+		if (component != RootComponent)
+		{
+			component->AttachToComponent(RootComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+			component->SetRelativeTransform(physicsComponentsRelativeTransforms[i], false, nullptr, ETeleportType::ResetPhysics);
+		}
+		component->SetSimulatePhysics(true);
+		component->SetPhysicsLinearVelocity(FVector::ZeroVector);
+		component->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+	}
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	bTargetActive = true;
+
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->RegisterActor(this);
+	}
+}
+
+void APawnObjectDestructibleTarget::DeactivateTarget()
+{
+	bTargetActive = false;
+	UGameplayTimingWheelSubsystem* timingWheel = GetWorld()->GetSubsystem<UGameplayTimingWheelSubsystem>();
+	if (timingWheel != nullptr)
+	{
+		timingWheel->ClearTimer(lifeTimerHandle);
+	}
+	// Mientras esta en el pool no debe volver a tickear por un cambio de significancia
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->UnregisterActor(this);
+	}
+
+	for (UPrimitiveComponent* component : physicsComponents)
+	{
+		if (component != nullptr)
+		{
+			component->SetSimulatePhysics(false);
+		}
 	}
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
 }
 
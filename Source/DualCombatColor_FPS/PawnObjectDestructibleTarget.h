@@ -4,10 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "GameplayTimingWheelSubsystem.h"
+#include "GameplayRoleActor.h"
 #include "PawnObjectDestructibleTarget.generated.h"
 
+class APawnObjectDestructibleTarget;
+
+DECLARE_DELEGATE_OneParam(FOnTargetReleased, APawnObjectDestructibleTarget*);
+
 UCLASS()
-class DUALCOMBATCOLOR_FPS_API APawnObjectDestructibleTarget : public APawn
+class DUALCOMBATCOLOR_FPS_API APawnObjectDestructibleTarget : public APawn, public IGameplayRoleActor
 {
 	GENERATED_BODY()
 
@@ -15,10 +21,26 @@ public:
 	// Sets default values for this pawn's properties
 	APawnObjectDestructibleTarget();
 
+	virtual EGameplayRole GetGameplayRoles() const override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	FGameplayTimerHandle lifeTimerHandle;
+
+	bool bTargetActive = true;
+
+	/** Components simulating physics when the target was first pooled, with their transform relative to the root. */
+	UPROPERTY()
+		TArray<class UPrimitiveComponent*> physicsComponents;
+
+	TArray<FTransform> physicsComponentsRelativeTransforms;
+
+	void CachePhysicsComponents();
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -32,7 +54,26 @@ public:
 	UPROPERTY(EditAnywhere)
 		float timeLife;
 
-	void StartTimeLife();
+	/** Schedules CheckLife after timeLife seconds, as part of the given timing wheel cohort. */
+	void StartTimeLife(int32 cohort = INDEX_NONE);
 
 	void CheckLife();
+
+	/** Falling out of the world returns the target to its pool instead of destroying it. */
+	virtual void FellOutOfWorld(const class UDamageType& dmgType) override;
+
+	/** Returns the target to its pool when it has one, otherwise destroys it. */
+	UFUNCTION(BlueprintCallable)
+		void DestroyTarget();
+
+	/** Places the target at the transform and turns on rendering, collision and physics again. */
+	void ActivateTarget(const FVector& location, const FRotator& rotation);
+
+	/** Hides the target and turns off collision, physics, tick and its life timer. */
+	void DeactivateTarget();
+
+	FORCEINLINE bool IsTargetActive() const { return bTargetActive; }
+
+	/** Bound by the pool owner. When bound, DestroyTarget deactivates the target and hands it back instead of destroying it. */
+	FOnTargetReleased OnTargetReleased;
 };
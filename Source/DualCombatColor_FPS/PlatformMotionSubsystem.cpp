@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlatformMotionSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+void UPlatformMotionSubsystem::Deinitialize()
+{
+	platforms.Empty();
+	baseLocations.Empty();
+	baseYaws.Empty();
+	horizontalAmplitudes.Empty();
+	verticalAmplitudes.Empty();
+	yawSpeeds.Empty();
+	creationTimes.Empty();
+	previousLocations.Empty();
+	currentLocations.Empty();
+	previousYaws.Empty();
+	currentYaws.Empty();
+	pushedLocations.Empty();
+	pushedYaws.Empty();
+	pushIntervals.Empty();
+	nextPushTimes.Empty();
+	platformIndices.Empty();
+	Super::Deinitialize();
+}
+
+void UPlatformMotionSubsystem::RegisterPlatform(AActor* platform, const FPlatformMotionParams& params)
+{
+	if (platform == nullptr || !params.IsMoving() || platformIndices.Contains(platform))
+	{
+		return;
+	}
+	const float time = GetWorld()->GetTimeSeconds();
+	const float runningTime = platform->GetGameTimeSinceCreation();
+	const FVector location = platform->GetActorLocation();
+	const float yaw = platform->GetActorRotation().Yaw;
+
+	// La base es la posicion que hace que la formula cerrada pase por donde esta la plataforma ahora
+	const float sine = FMath::Sin(runningTime);
+	FVector baseLocation = location;
+	baseLocation.X -= params.horizontalAmplitude * sine;
+	baseLocation.Z -= params.verticalAmplitude * sine;
+
+	platformIndices.Add(platform, platforms.Num());
+	platforms.Add(platform);
+	baseLocations.Add(baseLocation);
+	baseYaws.Add(yaw - params.yawSpeed * runningTime);
+	horizontalAmplitudes.Add(params.horizontalAmplitude);
+	verticalAmplitudes.Add(params.verticalAmplitude);
+	yawSpeeds.Add(params.yawSpeed);
+	creationTimes.Add(time - runningTime);
+	previousLocations.Add(location);
+	currentLocations.Add(location);
+	previousYaws.Add(yaw);
+	currentYaws.Add(yaw);
+	pushedLocations.Add(location);
+	pushedYaws.Add(yaw);
+	pushIntervals.Add(0.0f);
+	nextPushTimes.Add(0.0f);
+
+	// Los pasos ya evaluados no incluyen esta plataforma
+	lastStep = INDEX_NONE;
+
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->RegisterActor(platform, FOnSignificanceTierChanged::CreateUObject(this, &UPlatformMotionSubsystem::OnPlatformSignificanceChanged));
+	}
+}
+
+void UPlatformMotionSubsystem::UnregisterPlatform(AActor* platform)
+{
+	int32 index = INDEX_NONE;
+	if (platformIndices.RemoveAndCopyValue(platform, index))
+	{
+		RemovePlatformAt(index);
+		USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+		if (significance != nullptr)
+		{
+			significance->UnregisterActor(platform);
+		}
+	}
+}
+
+void UPlatformMotionSubsystem::OnPlatformSignificanceChanged(AActor* platform, ESignificanceTier tier)
+{
+	const int32* index = platformIndices.Find(platform);
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (index != nullptr && significance != nullptr)
+	{
+		pushIntervals[*index] = significance->GetTierTickInterval(tier);
+		nextPushTimes[*index] = 0.0f;
+	}
+}
+
+bool UPlatformMotionSubsystem::GetPlatformTransformAtTime(const AActor* platform, float time, FVector& outLocation, float& outYaw) const
+{
+	const int32* index = platformIndices.Find(const_cast<AActor*>(platform));
+	if (index == nullptr)
+	{
+		return false;
+	}
+	const int32 i = *index;
+	const float sine = FMath::Sin(time - creationTimes[i]);
+	outLocation = baseLocations[i];
+	outLocation.X += horizontalAmplitudes[i] * sine;
+	outLocation.Z += verticalAmplitudes[i] * sine;
+	outYaw = baseYaws[i] + yawSpeeds[i] * (time - creationTimes[i]);
+	return true;
+}
+
+void UPlatformMotionSubsystem::RewindMotion(float seconds)
+{
+	// El movimiento es una formula cerrada del tiempo desde la creacion, basta con correr ese origen
+	for (float& creationTime : creationTimes)
+	{
+		creationTime += seconds;
+	}
+	for (float& nextPushTime : nextPushTimes)
+	{
+		nextPushTime = 0.0f;
+	}
+	lastStep = INDEX_NONE;
+}
+
+void UPlatformMotionSubsystem::RemovePlatformAt(int32 index)
+{
+	platforms.RemoveAtSwap(index, 1, false);
+	baseLocations.RemoveAtSwap(index, 1, false);
+	baseYaws.RemoveAtSwap(index, 1, false);
+	horizontalAmplitudes.RemoveAtSwap(index, 1, false);
+	verticalAmplitudes.RemoveAtSwap(index, 1, false);
+	yawSpeeds.RemoveAtSwap(index, 1, false);
+	creationTimes.RemoveAtSwap(index, 1, false);
+	previousLocations.RemoveAtSwap(index, 1, false);
+	currentLocations.RemoveAtSwap(index, 1, false);
+	previousYaws.RemoveAtSwap(index, 1, false);
+	currentYaws.RemoveAtSwap(index, 1, false);
+	pushedLocations.RemoveAtSwap(index, 1, false);
+	pushedYaws.RemoveAtSwap(index, 1, false);
+	pushIntervals.RemoveAtSwap(index, 1, false);
+	nextPushTimes.RemoveAtSwap(index, 1, false);
+
+	// La ultima plataforma ocupa el lugar de la borrada
+	if (platforms.IsValidIndex(index))
+	{
+		platformIndices.Add(platforms[index], index);
+	}
+}
+
+void UPlatformMotionSubsystem::Tick(float DeltaTime)
+{
+	const float time = GetWorld()->GetTimeSeconds();
+	const float stepSeconds = GetStepSeconds();
+	const int64 step = FMath::FloorToInt(time / stepSeconds);
+
+	// Los pasos salen del tiempo del mundo y no de sumar DeltaTime, asi no se acumula error
+	if (step != lastStep)
+	{
+		if (step == lastStep + 1 && lastStep != INDEX_NONE)
+		{
+			Swap(previousLocations, currentLocations);
+			Swap(previousYaws, currentYaws);
+		}
+		else
+		{
+			Evaluate((step - 1) * stepSeconds, previousLocations, previousYaws);
+		}
+		Evaluate(step * stepSeconds, currentLocations, currentYaws);
+		lastStep = step;
+	}
+
+	const float alpha = FMath::Clamp((time - step * stepSeconds) / stepSeconds, 0.0f, 1.0f);
+	PushTransforms(time, alpha);
+}
+
+bool UPlatformMotionSubsystem::IsTickable() const
+{
+	return !IsTemplate() && platforms.Num() > 0;
+}
+
+TStatId UPlatformMotionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPlatformMotionSubsystem, STATGROUP_Tickables);
+}
+
+void UPlatformMotionSubsystem::Evaluate(float time, TArray<FVector>& outLocations, TArray<float>& outYaws) const
+{
+	const int32 count = platforms.Num();
+	outLocations.SetNumUninitialized(count, false);
+	outYaws.SetNumUninitialized(count, false);
+
+	FVector* RESTRICT location = outLocations.GetData();
+	float* RESTRICT yaw = outYaws.GetData();
+	const FVector* RESTRICT baseLocation = baseLocations.GetData();
+	const float* RESTRICT baseYaw = baseYaws.GetData();
+	const float* RESTRICT horizontalAmplitude = horizontalAmplitudes.GetData();
+	const float* RESTRICT verticalAmplitude = verticalAmplitudes.GetData();
+	const float* RESTRICT yawSpeed = yawSpeeds.GetData();
+	const float* RESTRICT creationTime = creationTimes.GetData();
+
+	// Una sola pasada lineal, un seno por plataforma y sin llamadas virtuales
+	for (int32 i = 0; i < count; i++)
+	{
+		const float runningTime = time - creationTime[i];
+		const float sine = FMath::Sin(runningTime);
+		location[i] = baseLocation[i];
+		location[i].X += horizontalAmplitude[i] * sine;
+		location[i].Z += verticalAmplitude[i] * sine;
+		yaw[i] = baseYaw[i] + yawSpeed[i] * runningTime;
+	}
+}
+
+void UPlatformMotionSubsystem::PushTransforms(float time, float alpha)
+{
+	for (int32 i = platforms.Num() - 1; i >= 0; i--)
+	{
+		AActor* platform = platforms[i].Get();
+		if (platform == nullptr)
+		{
+			platformIndices.Remove(platforms[i]);
+			RemovePlatformAt(i);
+			continue;
+		}
+		if (pushIntervals[i] < 0.0f || time < nextPushTimes[i])
+		{
+			continue;
+		}
+		nextPushTimes[i] = time + pushIntervals[i];
+
+		const FVector location = FMath::Lerp(previousLocations[i], currentLocations[i], alpha);
+		const float yaw = FMath::Lerp(previousYaws[i], currentYaws[i], alpha);
+		if (location.Equals(pushedLocations[i]) && FMath::IsNearlyEqual(yaw, pushedYaws[i]))
+		{
+			continue;
+		}
+		pushedLocations[i] = location;
+		pushedYaws[i] = yaw;
+
+		FRotator rotation = platform->GetActorRotation();
+		rotation.Yaw = FRotator::NormalizeAxis(yaw);
+		platform->SetActorLocationAndRotation(location, rotation);
+	}
+}
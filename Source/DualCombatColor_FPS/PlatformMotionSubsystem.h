@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SignificanceTickSubsystem.h"
+#include "PlatformMotionSubsystem.generated.h"
+
+/** Motion of one platform: a sine on X and Z plus a constant yaw speed. */
+struct FPlatformMotionParams
+{
+	/** Sine amplitude on X, already multiplied by the horizontal speed. */
+	float horizontalAmplitude = 0.0f;
+	/** Sine amplitude on Z, already multiplied by the vertical speed. */
+	float verticalAmplitude = 0.0f;
+	/** Degrees of yaw per second. */
+	float yawSpeed = 0.0f;
+
+	FORCEINLINE bool IsMoving() const
+	{
+		return horizontalAmplitude != 0.0f || verticalAmplitude != 0.0f || yawSpeed != 0.0f;
+	}
+};
+
+/**
+ * Moves every APlatformPawn and AMovePlatform of the world in one batch.
+ * Platform motion is closed form: base location plus amplitude * sin(time since creation),
+ * and base yaw plus yaw speed * time. The batch is evaluated at a fixed simulation rate
+ * and the rendered transform is interpolated between the last two steps, so the motion
+ * does not depend on the frame rate and the same time always gives the same transform.
+ * Only platforms whose transform changed are pushed to their actor, and less often for
+ * platforms far from the player. Dormant platforms are not pushed at all and snap to
+ * the right place when they wake up.
+ */
+UCLASS(config=Game)
+class DUALCOMBATCOLOR_FPS_API UPlatformMotionSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Simulation steps per second. Rendering interpolates between steps. */
+	UPROPERTY(Config)
+		float simulationRate = 30.0f;
+
+	/** Adds the platform to the batch. Platforms that do not move are ignored. */
+	void RegisterPlatform(AActor* platform, const FPlatformMotionParams& params);
+	void UnregisterPlatform(AActor* platform);
+
+	/** Location and yaw of a registered platform at a world time. Returns false if the platform is not registered. */
+	bool GetPlatformTransformAtTime(const AActor* platform, float time, FVector& outLocation, float& outYaw) const;
+
+	FORCEINLINE int32 GetPlatformCount() const { return platforms.Num(); }
+
+	/** True if the subsystem moves this actor, so its transform is owned by the batch. */
+	FORCEINLINE bool IsPlatformDriven(const AActor* platform) const { return platformIndices.Contains(const_cast<AActor*>(platform)); }
+
+	/** Delays the motion of every platform by the given seconds, so each one replays from where it was that long ago. */
+	void RewindMotion(float seconds);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject
+
+private:
+	FORCEINLINE float GetStepSeconds() const { return 1.0f / FMath::Max(simulationRate, 1.0f); }
+
+	/** Evaluates every platform at the time into the given arrays. */
+	void Evaluate(float time, TArray<FVector>& outLocations, TArray<float>& outYaws) const;
+	void PushTransforms(float time, float alpha);
+	void RemovePlatformAt(int32 index);
+	void OnPlatformSignificanceChanged(AActor* platform, ESignificanceTier tier);
+
+	// Datos de las plataformas en arrays empaquetados, el indice es el mismo en todos
+	TArray<TWeakObjectPtr<AActor>> platforms;
+	TArray<FVector> baseLocations;
+	TArray<float> baseYaws;
+	TArray<float> horizontalAmplitudes;
+	TArray<float> verticalAmplitudes;
+	TArray<float> yawSpeeds;
+	TArray<float> creationTimes;
+
+	// Resultado de los dos ultimos pasos fijos y lo ultimo que se mando a cada actor
+	TArray<FVector> previousLocations;
+	TArray<FVector> currentLocations;
+	TArray<float> previousYaws;
+	TArray<float> currentYaws;
+	TArray<FVector> pushedLocations;
+	TArray<float> pushedYaws;
+
+	// Cada cuanto se manda el transform al actor segun su nivel de significancia, negativo si esta dormida
+	TArray<float> pushIntervals;
+	TArray<float> nextPushTimes;
+
+	TMap<TWeakObjectPtr<AActor>, int32> platformIndices;
+
+	/** Index of the last evaluated fixed step, INDEX_NONE to force a new evaluation. */
+	int64 lastStep = INDEX_NONE;
+};
@@ -2,12 +2,15 @@
 
 
 #include "PlatformPawn.h"
+#include "Engine/World.h"
+#include "PlatformMotionSubsystem.h"
+#include "PlatformRegistrySubsystem.h"
 
 // Sets default values
 APlatformPawn::APlatformPawn()
 {
- 	// Set this pawn to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// El movimiento lo hace UPlatformMotionSubsystem, las plataformas no tickean
+	PrimaryActorTick.bCanEverTick = false;
 	bIsTread = false;
 
 	isStatic = true;
@@ -30,54 +33,50 @@ APlatformPawn::APlatformPawn()
 void APlatformPawn::BeginPlay()
 {
 	Super::BeginPlay();
-	
+	UPlatformRegistrySubsystem* platformRegistry = GetWorld()->GetSubsystem<UPlatformRegistrySubsystem>();
+	if (platformRegistry != nullptr)
+	{
+		platformId = platformRegistry->RegisterPlatform(this);
+	}
+	// Las plataformas estaticas no se registran y no cuestan nada por frame
+	UPlatformMotionSubsystem* motionSubsystem = GetWorld()->GetSubsystem<UPlatformMotionSubsystem>();
+	if (motionSubsystem != nullptr)
+	{
+		motionSubsystem->RegisterPlatform(this, GetMotionParams());
+	}
 }
 
-void APlatformPawn::Rotate(float DeltaTime)
+EGameplayRole APlatformPawn::GetGameplayRoles() const
 {
-    if (canRotate)
-    {
-        float DeltaRotation = DeltaTime * rotationDegrees * rotationSpeed;
-        NewRotation.Yaw += DeltaRotation;
-    }
-
-}
-
-void APlatformPawn::MoveVertical(float DeltaTime)
-{
-    if (canMoveVertical)
-    {
-        float DeltaHeight = (FMath::Sin(RunningTime + DeltaTime) - FMath::Sin(RunningTime));
-        NewLocation.Z += DeltaHeight * maxHeight * moveVerticalSpeed;
-    }
+	return EGameplayRole::Platform | IGameplayRoleActor::GetRolesFromTags(this);
 }
 
-void APlatformPawn::MoveHorizontal(float DeltaTime)
+void APlatformPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (canMoveHorizontal)
-    {
-        float DeltaHorizontal = (FMath::Sin(RunningTime + DeltaTime) - FMath::Sin(RunningTime));
-        NewLocation.X += DeltaHorizontal * maxHorizontal * moveHorizontalSpeed;
-    }
+	UPlatformMotionSubsystem* motionSubsystem = GetWorld()->GetSubsystem<UPlatformMotionSubsystem>();
+	if (motionSubsystem != nullptr)
+	{
+		motionSubsystem->UnregisterPlatform(this);
+	}
+	UPlatformRegistrySubsystem* platformRegistry = GetWorld()->GetSubsystem<UPlatformRegistrySubsystem>();
+	if (platformRegistry != nullptr)
+	{
+		platformRegistry->UnregisterPlatform(platformId);
+		platformId = INDEX_NONE;
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
-// Called every frame
-void APlatformPawn::Tick(float DeltaTime)
+FPlatformMotionParams APlatformPawn::GetMotionParams() const
 {
-	Super::Tick(DeltaTime);
-
-    NewLocation = GetActorLocation();
-    NewRotation = GetActorRotation();
-    RunningTime = GetGameTimeSinceCreation();
-
-    if (!isStatic) 
-    {
-        MoveVertical(DeltaTime);
-        MoveHorizontal(DeltaTime);
-        Rotate(DeltaTime);
-    }   
-   
-    SetActorLocationAndRotation(NewLocation, NewRotation);
+	FPlatformMotionParams params;
+	if (!isStatic)
+	{
+		params.horizontalAmplitude = canMoveHorizontal ? maxHorizontal * moveHorizontalSpeed : 0.0f;
+		params.verticalAmplitude = canMoveVertical ? maxHeight * moveVerticalSpeed : 0.0f;
+		params.yawSpeed = canRotate ? rotationDegrees * rotationSpeed : 0.0f;
+	}
+	return params;
 }
 
 // Called to bind functionality to input
@@ -4,23 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "PlatformMotionSubsystem.h"
+#include "GameplayRoleActor.h"
 #include "PlatformPawn.generated.h"
 
 UCLASS()
-class DUALCOMBATCOLOR_FPS_API APlatformPawn : public APawn
+class DUALCOMBATCOLOR_FPS_API APlatformPawn : public APawn, public IGameplayRoleActor
 {
 	GENERATED_BODY()
-private:
-	UPROPERTY()
-	FVector NewLocation;
-	UPROPERTY()
-	FRotator NewRotation;
 
-	float RunningTime;
 public:
 	// Sets default values for this pawn's properties
 	APlatformPawn();
 
+	virtual EGameplayRole GetGameplayRoles() const override;
+
 	UPROPERTY(EditAnywhere)
 		float wight;
 
@@ -29,6 +27,13 @@ public:
 
 	bool bIsTread;
 
+	/** Treading this platform saves a respawn point on it. */
+	UPROPERTY(EditAnywhere)
+		bool bIsCheckpoint = false;
+
+	/** Id given by UPlatformRegistrySubsystem, INDEX_NONE before BeginPlay. */
+	FORCEINLINE int32 GetPlatformId() const { return platformId; }
+
 	// Movement Settings
 	UPROPERTY(EditAnywhere)
 		bool isStatic;
@@ -58,18 +63,14 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	UFUNCTION()
-	void Rotate(float DeltaTime);
-	UFUNCTION()
-	void MoveVertical(float DeltaTime);
-	UFUNCTION()
-	void MoveHorizontal(float DeltaTime);
+	int32 platformId = INDEX_NONE;
 
+public:	
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** Motion handed to UPlatformMotionSubsystem, which moves the platform instead of Tick. */
+	FPlatformMotionParams GetMotionParams() const;
 
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlatformRegistrySubsystem.h"
+#include "PlatformPawn.h"
+
+void UPlatformRegistrySubsystem::Deinitialize()
+{
+	records.Empty();
+	grid.Empty();
+	Super::Deinitialize();
+}
+
+int32 UPlatformRegistrySubsystem::RegisterPlatform(APlatformPawn* platform)
+{
+	if (platform == nullptr)
+	{
+		return INDEX_NONE;
+	}
+	FPlatformRecord record;
+	record.platform = platform;
+	record.location = platform->GetActorLocation();
+	record.cell = GetCell(record.location);
+	const int32 platformId = records.Add(record);
+	AddToCell(record.cell, platformId);
+	return platformId;
+}
+
+void UPlatformRegistrySubsystem::UnregisterPlatform(int32 platformId)
+{
+	if (!records.IsValidIndex(platformId))
+	{
+		return;
+	}
+	RemoveFromCell(records[platformId].cell, platformId);
+	records.RemoveAt(platformId);
+}
+
+void UPlatformRegistrySubsystem::UpdatePlatform(int32 platformId)
+{
+	if (!records.IsValidIndex(platformId))
+	{
+		return;
+	}
+	FPlatformRecord& record = records[platformId];
+	const APlatformPawn* platform = record.platform.Get();
+	if (platform == nullptr)
+	{
+		return;
+	}
+	record.location = platform->GetActorLocation();
+	const FIntVector cell = GetCell(record.location);
+	if (cell != record.cell)
+	{
+		RemoveFromCell(record.cell, platformId);
+		AddToCell(cell, platformId);
+		record.cell = cell;
+	}
+}
+
+APlatformPawn* UPlatformRegistrySubsystem::GetPlatform(int32 platformId) const
+{
+	return records.IsValidIndex(platformId) ? records[platformId].platform.Get() : nullptr;
+}
+
+void UPlatformRegistrySubsystem::QueryRadius(const FVector& center, float radius, TArray<APlatformPawn*>& outPlatforms) const
+{
+	const float radiusSquared = radius * radius;
+	QueryCells(FBox(center - FVector(radius), center + FVector(radius)), outPlatforms, [&center, radiusSquared](const FVector& location)
+	{
+		return FVector::DistSquared(location, center) <= radiusSquared;
+	});
+}
+
+void UPlatformRegistrySubsystem::QueryBox(const FBox& box, TArray<APlatformPawn*>& outPlatforms) const
+{
+	QueryCells(box, outPlatforms, [&box](const FVector& location)
+	{
+		return box.IsInsideOrOn(location);
+	});
+}
+
+void UPlatformRegistrySubsystem::GetAllPlatforms(TArray<APlatformPawn*>& outPlatforms) const
+{
+	outPlatforms.Reserve(outPlatforms.Num() + records.Num());
+	for (const FPlatformRecord& record : records)
+	{
+		if (APlatformPawn* platform = record.platform.Get())
+		{
+			outPlatforms.Add(platform);
+		}
+	}
+}
+
+template<typename Predicate>
+void UPlatformRegistrySubsystem::QueryCells(const FBox& bounds, TArray<APlatformPawn*>& outPlatforms, Predicate isInside) const
+{
+	const FIntVector minCell = GetCell(bounds.Min);
+	const FIntVector maxCell = GetCell(bounds.Max);
+	for (int32 z = minCell.Z; z <= maxCell.Z; z++)
+	{
+		for (int32 y = minCell.Y; y <= maxCell.Y; y++)
+		{
+			for (int32 x = minCell.X; x <= maxCell.X; x++)
+			{
+				const TArray<int32>* cellPlatforms = grid.Find(FIntVector(x, y, z));
+				if (cellPlatforms == nullptr)
+				{
+					continue;
+				}
+				for (int32 platformId : *cellPlatforms)
+				{
+					const FPlatformRecord& record = records[platformId];
+					APlatformPawn* platform = record.platform.Get();
+					if (platform != nullptr && isInside(record.location))
+					{
+						outPlatforms.Add(platform);
+					}
+				}
+			}
+		}
+	}
+}
+
+FIntVector UPlatformRegistrySubsystem::GetCell(const FVector& location) const
+{
+	const float size = FMath::Max(cellSize, 1.0f);
+	return FIntVector(FMath::FloorToInt(location.X / size), FMath::FloorToInt(location.Y / size), FMath::FloorToInt(location.Z / size));
+}
+
+void UPlatformRegistrySubsystem::AddToCell(const FIntVector& cell, int32 platformId)
+{
+	grid.FindOrAdd(cell).Add(platformId);
+}
+
+void UPlatformRegistrySubsystem::RemoveFromCell(const FIntVector& cell, int32 platformId)
+{
+	TArray<int32>* cellPlatforms = grid.Find(cell);
+	if (cellPlatforms == nullptr)
+	{
+		return;
+	}
+	cellPlatforms->RemoveSingleSwap(platformId, false);
+	if (cellPlatforms->Num() == 0)
+	{
+		grid.Remove(cell);
+	}
+}
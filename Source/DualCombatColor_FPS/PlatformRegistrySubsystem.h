@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlatformRegistrySubsystem.generated.h"
+
+class APlatformPawn;
+
+struct FPlatformRecord
+{
+	TWeakObjectPtr<APlatformPawn> platform;
+	FVector location;
+	FIntVector cell;
+};
+
+/**
+ * Every APlatformPawn registers itself here in BeginPlay and gets an id. Platforms are
+ * kept in a uniform grid so gameplay code can ask for the platforms near a point or
+ * inside a box without walking the whole world. Moving platforms are indexed at the
+ * location they had when they registered, or when UpdatePlatform was last called.
+ */
+UCLASS(config=Game)
+class DUALCOMBATCOLOR_FPS_API UPlatformRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Size of a grid cell. Queries visit every cell touched by their bounds. */
+	UPROPERTY(Config)
+		float cellSize = 2000.0f;
+
+	/** Adds the platform and returns its id. */
+	int32 RegisterPlatform(APlatformPawn* platform);
+	void UnregisterPlatform(int32 platformId);
+
+	/** Moves the platform to the cell of its current location. */
+	void UpdatePlatform(int32 platformId);
+
+	/** Platform with the id, nullptr if it was unregistered or destroyed. */
+	APlatformPawn* GetPlatform(int32 platformId) const;
+
+	/** Appends the platforms whose indexed location is inside the sphere. */
+	void QueryRadius(const FVector& center, float radius, TArray<APlatformPawn*>& outPlatforms) const;
+
+	/** Appends the platforms whose indexed location is inside the box. */
+	void QueryBox(const FBox& box, TArray<APlatformPawn*>& outPlatforms) const;
+
+	/** Appends every registered platform. */
+	void GetAllPlatforms(TArray<APlatformPawn*>& outPlatforms) const;
+
+	FORCEINLINE int32 GetPlatformCount() const { return records.Num(); }
+
+private:
+	FIntVector GetCell(const FVector& location) const;
+	void AddToCell(const FIntVector& cell, int32 platformId);
+	void RemoveFromCell(const FIntVector& cell, int32 platformId);
+
+	template<typename Predicate>
+	void QueryCells(const FBox& bounds, TArray<APlatformPawn*>& outPlatforms, Predicate isInside) const;
+
+	// El id de cada plataforma es su indice en el sparse array, asi la busqueda por id es directa
+	TSparseArray<FPlatformRecord> records;
+	TMap<FIntVector, TArray<int32>> grid;
+};
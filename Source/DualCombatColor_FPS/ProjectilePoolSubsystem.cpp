@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProjectilePoolSubsystem.h"
+#include "Engine/World.h"
+#include "DualCombatColor_FPSProjectile.h"
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	LogPoolStats();
+	pools.Empty();
+	Super::Deinitialize();
+}
+
+void UProjectilePoolSubsystem::Prewarm(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass, int32 count)
+{
+	if (projectileClass == nullptr)
+	{
+		return;
+	}
+	FProjectilePool& pool = pools.FindOrAdd(projectileClass);
+	int32 missing = count - (pool.stats.free + pool.stats.active);
+	pool.freeProjectiles.Reserve(pool.freeProjectiles.Num() + FMath::Max(missing, 0));
+	for (int32 i = 0; i < missing; i++)
+	{
+		ADualCombatColor_FPSProjectile* projectile = SpawnPooledProjectile(projectileClass);
+		if (projectile != nullptr)
+		{
+			pool.freeProjectiles.Add(projectile);
+			pool.stats.free++;
+		}
+	}
+}
+
+ADualCombatColor_FPSProjectile* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass, const FVector& location, const FRotator& rotation)
+{
+	if (projectileClass == nullptr)
+	{
+		return nullptr;
+	}
+	if (!pools.Contains(projectileClass))
+	{
+		Prewarm(projectileClass, defaultPoolSize);
+	}
+	FProjectilePool& pool = pools.FindChecked(projectileClass);
+	pool.stats.acquired++;
+
+	ADualCombatColor_FPSProjectile* projectile = nullptr;
+	while (projectile == nullptr && pool.freeProjectiles.Num() > 0)
+	{
+		// Los proyectiles del pool pueden haber sido destruidos por el nivel (streaming, kill Z...)
+		projectile = pool.freeProjectiles.Pop(false);
+		pool.stats.free--;
+		if (projectile != nullptr && projectile->IsPendingKill())
+		{
+			projectile = nullptr;
+		}
+	}
+	if (projectile == nullptr)
+	{
+		pool.stats.misses++;
+		projectile = SpawnPooledProjectile(projectileClass);
+		if (projectile == nullptr)
+		{
+			return nullptr;
+		}
+	}
+
+	pool.activeProjectiles.Add(projectile);
+	pool.stats.active++;
+	pool.stats.highWaterMark = FMath::Max(pool.stats.highWaterMark, pool.stats.active);
+	projectile->ActivateProjectile(location, rotation);
+	return projectile;
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(ADualCombatColor_FPSProjectile* projectile)
+{
+	if (projectile == nullptr || !projectile->IsProjectileActive())
+	{
+		return;
+	}
+	projectile->DeactivateProjectile();
+
+	FProjectilePool* pool = pools.Find(projectile->GetClass());
+	if (pool == nullptr)
+	{
+		projectile->Destroy();
+		return;
+	}
+	pool->activeProjectiles.RemoveSingleSwap(projectile, false);
+	pool->freeProjectiles.Add(projectile);
+	pool->stats.free++;
+	pool->stats.active--;
+}
+
+void UProjectilePoolSubsystem::ReleaseAllProjectiles()
+{
+	for (TPair<UClass*, FProjectilePool>& pair : pools)
+	{
+		// Se copia porque ReleaseProjectile saca el proyectil de la lista
+		TArray<ADualCombatColor_FPSProjectile*> activeProjectiles = pair.Value.activeProjectiles;
+		for (ADualCombatColor_FPSProjectile* projectile : activeProjectiles)
+		{
+			if (projectile != nullptr && !projectile->IsPendingKill())
+			{
+				ReleaseProjectile(projectile);
+			}
+		}
+		pair.Value.activeProjectiles.Reset();
+		pair.Value.stats.active = 0;
+	}
+}
+
+FProjectilePoolStats UProjectilePoolSubsystem::GetPoolStats(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass) const
+{
+	const FProjectilePool* pool = pools.Find(projectileClass);
+	return pool != nullptr ? pool->stats : FProjectilePoolStats();
+}
+
+void UProjectilePoolSubsystem::LogPoolStats() const
+{
+	for (const TPair<UClass*, FProjectilePool>& pair : pools)
+	{
+		const FProjectilePoolStats& stats = pair.Value.stats;
+		UE_LOG(LogTemp, Log, TEXT("ProjectilePool %s: active %d, free %d, high water mark %d, acquired %d, misses %d"),
+			*GetNameSafe(pair.Key), stats.active, stats.free, stats.highWaterMark, stats.acquired, stats.misses);
+	}
+}
+
+ADualCombatColor_FPSProjectile* UProjectilePoolSubsystem::SpawnPooledProjectile(UClass* projectileClass)
+{
+	UWorld* world = GetWorld();
+	if (world == nullptr)
+	{
+		return nullptr;
+	}
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ADualCombatColor_FPSProjectile* projectile = world->SpawnActor<ADualCombatColor_FPSProjectile>(projectileClass, FVector::ZeroVector, FRotator::ZeroRotator, spawnParams);
+	if (projectile != nullptr)
+	{
+		projectile->SetPooled(this);
+		projectile->DeactivateProjectile();
+	}
+	return projectile;
+}
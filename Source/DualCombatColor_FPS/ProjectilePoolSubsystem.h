@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class ADualCombatColor_FPSProjectile;
+
+USTRUCT(BlueprintType)
+struct FProjectilePoolStats
+{
+	GENERATED_BODY()
+public:
+	/** Projectiles currently in flight. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 active = 0;
+	/** Projectiles sitting deactivated in the pool. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 free = 0;
+	/** Highest number of projectiles in flight at the same time. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 highWaterMark = 0;
+	/** Total number of AcquireProjectile calls. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 acquired = 0;
+	/** Acquires that found the pool empty and had to spawn a new actor. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 misses = 0;
+};
+
+USTRUCT()
+struct FProjectilePool
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+		TArray<ADualCombatColor_FPSProjectile*> freeProjectiles;
+
+	/** Projectiles handed out and not yet released, so they can all be recalled at once. */
+	UPROPERTY()
+		TArray<ADualCombatColor_FPSProjectile*> activeProjectiles;
+
+	UPROPERTY()
+		FProjectilePoolStats stats;
+};
+
+/**
+ * Keeps a per-class pool of deactivated projectiles so the player and the canyons
+ * do not spawn and destroy a full actor for every shot.
+ */
+UCLASS(config=Game)
+class DUALCOMBATCOLOR_FPS_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Number of projectiles created for a class the first time it is requested. */
+	UPROPERTY(Config)
+		int32 defaultPoolSize = 16;
+
+	/** Makes sure at least count projectiles of the class exist in the pool. */
+	void Prewarm(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass, int32 count);
+
+	/** Hands out a projectile placed and launched at the given transform. Spawns one if the pool is empty. */
+	ADualCombatColor_FPSProjectile* AcquireProjectile(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass, const FVector& location, const FRotator& rotation);
+
+	/** Deactivates the projectile and puts it back in the pool of its class. */
+	void ReleaseProjectile(ADualCombatColor_FPSProjectile* projectile);
+
+	/** Puts every projectile in flight back in its pool. */
+	void ReleaseAllProjectiles();
+
+	UFUNCTION(BlueprintCallable)
+		FProjectilePoolStats GetPoolStats(TSubclassOf<ADualCombatColor_FPSProjectile> projectileClass) const;
+
+	void LogPoolStats() const;
+
+private:
+	ADualCombatColor_FPSProjectile* SpawnPooledProjectile(UClass* projectileClass);
+
+	UPROPERTY()
+		TMap<UClass*, FProjectilePool> pools;
+};
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RayObstacleSubsystem.h"
+#include "Engine/World.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+#include "ActorObstacleRay.h"
+
+static TAutoConsoleVariable<int32> CVarRayObstacleDrawDebug(
+	TEXT("parkour.RayObstacle.DrawDebug"),
+	1,
+	TEXT("Draws the debug line of every ray obstacle. 0: off, 1: on"),
+	ECVF_Cheat);
+
+void URayObstacleSubsystem::Deinitialize()
+{
+	rays.Empty();
+	Super::Deinitialize();
+}
+
+void URayObstacleSubsystem::RegisterRay(AActorObstacleRay* ray)
+{
+	if (ray == nullptr)
+	{
+		return;
+	}
+	FRayObstacleEntry entry;
+	entry.ray = ray;
+	// Reparte la primera actualizacion de los rayos lentos para que no tracen todos en el mismo frame
+	entry.timeUntilUpdate = FMath::FRandRange(0.0f, ray->updateInterval);
+	rays.Add(entry);
+
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		// El rayo hace danio, nunca se duerme y se puntua por el punto del haz mas cercano, no por su origen
+		significance->RegisterActor(ray, FOnSignificanceTierChanged::CreateUObject(this, &URayObstacleSubsystem::OnRaySignificanceChanged),
+			FGetSignificanceLocation::CreateUObject(ray, &AActorObstacleRay::GetClosestRayPoint), false);
+	}
+}
+
+void URayObstacleSubsystem::UnregisterRay(AActorObstacleRay* ray)
+{
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->UnregisterActor(ray);
+	}
+	for (FRayObstacleEntry& entry : rays)
+	{
+		if (entry.ray.Get() == ray)
+		{
+			entry.ray = nullptr;
+			bHasRemovedRays = true;
+		}
+	}
+}
+
+void URayObstacleSubsystem::Tick(float DeltaTime)
+{
+	// Los resultados de las trazas del frame anterior ya estan listos, primero se aplican y despues se piden las nuevas
+	for (int32 i = 0; i < rays.Num(); i++)
+	{
+		if (rays[i].ray.IsValid())
+		{
+			ConsumeTraceResult(rays[i]);
+		}
+	}
+	for (int32 i = 0; i < rays.Num(); i++)
+	{
+		FRayObstacleEntry& entry = rays[i];
+		if (!entry.ray.IsValid())
+		{
+			continue;
+		}
+		entry.timeUntilUpdate -= DeltaTime;
+		if (entry.timeUntilUpdate <= 0.0f)
+		{
+			const float updateInterval = FMath::Max(entry.ray->updateInterval, entry.significanceInterval);
+			entry.timeUntilUpdate = FMath::Max(entry.timeUntilUpdate + updateInterval, 0.0f);
+			SubmitTrace(entry);
+		}
+	}
+
+	if (bHasRemovedRays)
+	{
+		rays.RemoveAllSwap([](const FRayObstacleEntry& entry) { return !entry.ray.IsValid(); });
+		bHasRemovedRays = false;
+	}
+}
+
+bool URayObstacleSubsystem::IsTickable() const
+{
+	return !IsTemplate() && rays.Num() > 0;
+}
+
+TStatId URayObstacleSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URayObstacleSubsystem, STATGROUP_Tickables);
+}
+
+void URayObstacleSubsystem::ConsumeTraceResult(FRayObstacleEntry& entry)
+{
+	if (!entry.pendingTrace.IsValid())
+	{
+		return;
+	}
+	FTraceDatum traceData;
+	if (GetWorld()->QueryTraceData(entry.pendingTrace, traceData))
+	{
+		entry.pendingTrace = FTraceHandle();
+		for (const FHitResult& hit : traceData.OutHits)
+		{
+			if (hit.bBlockingHit)
+			{
+				entry.ray->ApplyRayHit(hit);
+				break;
+			}
+		}
+	}
+	else
+	{
+		// El resultado solo vive un frame, si se perdio se vuelve a pedir
+		entry.pendingTrace = FTraceHandle();
+	}
+}
+
+void URayObstacleSubsystem::OnRaySignificanceChanged(AActor* ray, ESignificanceTier tier)
+{
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	for (FRayObstacleEntry& entry : rays)
+	{
+		if (entry.ray.Get() == ray)
+		{
+			// La significancia solo puede bajar el ritmo hasta el del nivel Medium, si no el jugador cruza el haz entre trazas
+			entry.significanceInterval = FMath::Clamp(significance->GetTierTickInterval(tier), 0.0f, significance->mediumTickInterval);
+		}
+	}
+}
+
+void URayObstacleSubsystem::SubmitTrace(FRayObstacleEntry& entry)
+{
+	AActorObstacleRay* ray = entry.ray.Get();
+	const FVector startPosition = ray->GetRayStart();
+	const FVector endPosition = ray->GetRayEnd();
+
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(RayObstacleTrace), false, ray);
+	entry.pendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, startPosition, endPosition, ray->TraceChannel, queryParams);
+
+#if ENABLE_DRAW_DEBUG
+	if (ray->bDrawDebugRay && CVarRayObstacleDrawDebug.GetValueOnGameThread() != 0)
+	{
+		DrawDebugLine(GetWorld(), startPosition, endPosition, FColor::Red, false, ray->updateInterval > 0.0f ? ray->updateInterval : -1.0f);
+	}
+#endif
+}
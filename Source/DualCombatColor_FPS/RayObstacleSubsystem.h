@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "SignificanceTickSubsystem.h"
+#include "RayObstacleSubsystem.generated.h"
+
+class AActorObstacleRay;
+
+struct FRayObstacleEntry
+{
+	TWeakObjectPtr<AActorObstacleRay> ray;
+	FTraceHandle pendingTrace;
+	float timeUntilUpdate = 0.0f;
+	/** Minimum seconds between traces set by the significance tier, never above the Medium tier interval. */
+	float significanceInterval = 0.0f;
+};
+
+/**
+ * Owns the traces of every AActorObstacleRay in the world. Rays are submitted with the
+ * async trace API and their hits are applied the next frame, so the game thread never
+ * waits on a physics query.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API URayObstacleSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterRay(AActorObstacleRay* ray);
+	void UnregisterRay(AActorObstacleRay* ray);
+
+	FORCEINLINE int32 GetRayCount() const { return rays.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject
+
+private:
+	void ConsumeTraceResult(FRayObstacleEntry& entry);
+	void SubmitTrace(FRayObstacleEntry& entry);
+	void OnRaySignificanceChanged(AActor* ray, ESignificanceTier tier);
+
+	TArray<FRayObstacleEntry> rays;
+
+	// Se activa cuando un rayo se desregistra durante el Tick (por ejemplo al destruirse por un golpe)
+	bool bHasRemovedRays = false;
+};
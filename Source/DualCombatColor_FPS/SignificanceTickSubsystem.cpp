@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SignificanceTickSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_STATS_GROUP(TEXT("Significance"), STATGROUP_Significance, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("High tier actors"), STAT_SignificanceHigh, STATGROUP_Significance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Medium tier actors"), STAT_SignificanceMedium, STATGROUP_Significance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Low tier actors"), STAT_SignificanceLow, STATGROUP_Significance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant actors"), STAT_SignificanceDormant, STATGROUP_Significance);
+
+void USignificanceTickSubsystem::Deinitialize()
+{
+	entries.Empty();
+	Super::Deinitialize();
+}
+
+void USignificanceTickSubsystem::RegisterActor(AActor* actor, FOnSignificanceTierChanged onTierChanged, FGetSignificanceLocation getLocation, bool bCanGoDormant)
+{
+	if (actor == nullptr)
+	{
+		return;
+	}
+	FSignificanceEntry entry;
+	entry.actor = actor;
+	entry.onTierChanged = onTierChanged;
+	entry.getLocation = getLocation;
+	entry.bCanGoDormant = bCanGoDormant;
+	entries.Add(entry);
+
+	// Se evalua enseguida para que los actores lejanos no tickeen a tope hasta la proxima pasada
+	timeUntilEvaluation = 0.0f;
+}
+
+void USignificanceTickSubsystem::UnregisterActor(AActor* actor)
+{
+	for (FSignificanceEntry& entry : entries)
+	{
+		if (entry.actor.Get() == actor)
+		{
+			entry.actor = nullptr;
+			bHasRemovedEntries = true;
+		}
+	}
+}
+
+float USignificanceTickSubsystem::GetTierTickInterval(ESignificanceTier tier) const
+{
+	switch (tier)
+	{
+	case ESignificanceTier::High:
+		return highTickInterval;
+	case ESignificanceTier::Medium:
+		return mediumTickInterval;
+	case ESignificanceTier::Low:
+		return lowTickInterval;
+	default:
+		return -1.0f;
+	}
+}
+
+int32 USignificanceTickSubsystem::GetTierCount(ESignificanceTier tier) const
+{
+	return tier < ESignificanceTier::Count ? tierCounts[(int32)tier] : 0;
+}
+
+void USignificanceTickSubsystem::Tick(float DeltaTime)
+{
+	if (bHasRemovedEntries)
+	{
+		entries.RemoveAllSwap([](const FSignificanceEntry& entry) { return !entry.actor.IsValid(); });
+		bHasRemovedEntries = false;
+	}
+
+	timeUntilEvaluation -= DeltaTime;
+	if (timeUntilEvaluation > 0.0f)
+	{
+		return;
+	}
+	timeUntilEvaluation = evaluationInterval;
+
+	APlayerController* playerController = GetWorld()->GetFirstPlayerController();
+	if (playerController == nullptr)
+	{
+		return;
+	}
+	FVector viewLocation;
+	FRotator viewRotation;
+	playerController->GetPlayerViewPoint(viewLocation, viewRotation);
+	const FVector viewDirection = viewRotation.Vector();
+
+	FMemory::Memzero(tierCounts);
+	for (FSignificanceEntry& entry : entries)
+	{
+		if (!entry.actor.IsValid())
+		{
+			bHasRemovedEntries = true;
+			continue;
+		}
+		const ESignificanceTier tier = ComputeTier(entry, viewLocation, viewDirection);
+		if (tier != entry.tier)
+		{
+			entry.tier = tier;
+			ApplyTier(entry);
+		}
+		tierCounts[(int32)tier]++;
+	}
+	UpdateStats();
+}
+
+bool USignificanceTickSubsystem::IsTickable() const
+{
+	return !IsTemplate() && entries.Num() > 0;
+}
+
+TStatId USignificanceTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USignificanceTickSubsystem, STATGROUP_Tickables);
+}
+
+ESignificanceTier USignificanceTickSubsystem::ComputeTier(FSignificanceEntry& entry, const FVector& viewLocation, const FVector& viewDirection) const
+{
+	const FVector actorLocation = entry.getLocation.IsBound() ? entry.getLocation.Execute(viewLocation) : entry.actor->GetActorLocation();
+	const FVector toActor = actorLocation - viewLocation;
+	const float distance = toActor.Size();
+
+	// Cada limite se corre hacia afuera si el actor esta de este lado y hacia adentro si esta del otro
+	const float thresholds[] = { mediumDistance, lowDistance, dormantDistance };
+	int32 tier = 0;
+	for (int32 i = 0; i < UE_ARRAY_COUNT(thresholds); i++)
+	{
+		const float band = (int32)entry.tier <= i ? 1.0f + hysteresis : 1.0f - hysteresis;
+		if (distance > thresholds[i] * band)
+		{
+			tier = i + 1;
+		}
+	}
+
+	const float halfAngle = entry.bVisible ? viewHalfAngle + viewHysteresisAngle : viewHalfAngle;
+	entry.bVisible = distance <= KINDA_SMALL_NUMBER || FVector::DotProduct(toActor / distance, viewDirection) >= FMath::Cos(FMath::DegreesToRadians(halfAngle));
+
+	// Lo que esta cerca sigue tickeando aunque este detras del jugador
+	if (!entry.bVisible && tier > (int32)ESignificanceTier::High)
+	{
+		tier = bSuspendOutOfView ? (int32)ESignificanceTier::Dormant : tier + 1;
+	}
+	const int32 lowestTier = entry.bCanGoDormant ? (int32)ESignificanceTier::Dormant : (int32)ESignificanceTier::Low;
+	return (ESignificanceTier)FMath::Min(tier, lowestTier);
+}
+
+void USignificanceTickSubsystem::ApplyTier(FSignificanceEntry& entry)
+{
+	AActor* actor = entry.actor.Get();
+	if (entry.onTierChanged.IsBound())
+	{
+		entry.onTierChanged.Execute(actor, entry.tier);
+		return;
+	}
+	if (!actor->PrimaryActorTick.bCanEverTick)
+	{
+		return;
+	}
+	const float tickInterval = GetTierTickInterval(entry.tier);
+	actor->SetActorTickEnabled(tickInterval >= 0.0f);
+	if (tickInterval >= 0.0f)
+	{
+		actor->SetActorTickInterval(tickInterval);
+	}
+}
+
+void USignificanceTickSubsystem::UpdateStats()
+{
+	SET_DWORD_STAT(STAT_SignificanceHigh, tierCounts[(int32)ESignificanceTier::High]);
+	SET_DWORD_STAT(STAT_SignificanceMedium, tierCounts[(int32)ESignificanceTier::Medium]);
+	SET_DWORD_STAT(STAT_SignificanceLow, tierCounts[(int32)ESignificanceTier::Low]);
+	SET_DWORD_STAT(STAT_SignificanceDormant, tierCounts[(int32)ESignificanceTier::Dormant]);
+}
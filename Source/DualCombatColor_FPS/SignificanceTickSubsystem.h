@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SignificanceTickSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class ESignificanceTier : uint8
+{
+	High,
+	Medium,
+	Low,
+	/** Far away or out of view: the actor does not tick at all. */
+	Dormant,
+	Count UMETA(Hidden)
+};
+
+DECLARE_DELEGATE_TwoParams(FOnSignificanceTierChanged, AActor*, ESignificanceTier);
+/** Point of the actor closest to the view location, for actors that are not well described by their origin. */
+DECLARE_DELEGATE_RetVal_OneParam(FVector, FGetSignificanceLocation, const FVector&);
+
+struct FSignificanceEntry
+{
+	TWeakObjectPtr<AActor> actor;
+	ESignificanceTier tier = ESignificanceTier::High;
+	bool bVisible = true;
+	/** When unbound the tier is applied to the actor tick. */
+	FOnSignificanceTierChanged onTierChanged;
+	/** When unbound the actor is scored from its location. */
+	FGetSignificanceLocation getLocation;
+	/** Gameplay that must keep running out of view stops at Low instead of going Dormant. */
+	bool bCanGoDormant = true;
+};
+
+/**
+ * Scores registered gameplay actors by their distance to the player's view and whether they
+ * are inside the view cone, and buckets them into tiers. Each tier sets the tick interval of
+ * the actor, and the Dormant tier turns its tick off. Actors moved by a subsystem instead of
+ * their own tick (platforms, rays) pass a delegate so the subsystem applies the tier.
+ * Tier changes use a hysteresis band so actors on a boundary do not flap between tiers.
+ */
+UCLASS(config=Game)
+class DUALCOMBATCOLOR_FPS_API USignificanceTickSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Distance from the player where the Medium, Low and Dormant tiers start. */
+	UPROPERTY(Config)
+		float mediumDistance = 2500.0f;
+	UPROPERTY(Config)
+		float lowDistance = 6000.0f;
+	UPROPERTY(Config)
+		float dormantDistance = 15000.0f;
+
+	/** Tick interval in seconds of the High, Medium and Low tiers. */
+	UPROPERTY(Config)
+		float highTickInterval = 0.0f;
+	UPROPERTY(Config)
+		float mediumTickInterval = 0.1f;
+	UPROPERTY(Config)
+		float lowTickInterval = 0.5f;
+
+	/** Fraction of a distance threshold an actor has to cross past it before it changes tier. */
+	UPROPERTY(Config)
+		float hysteresis = 0.1f;
+
+	/** Half angle in degrees of the view cone. Actors outside of it drop one tier, or go Dormant when suspendOutOfView is set. */
+	UPROPERTY(Config)
+		float viewHalfAngle = 60.0f;
+
+	/** Extra degrees an actor in view keeps before it counts as out of view. */
+	UPROPERTY(Config)
+		float viewHysteresisAngle = 10.0f;
+
+	UPROPERTY(Config)
+		bool bSuspendOutOfView = true;
+
+	/** Seconds between two evaluations of every actor. */
+	UPROPERTY(Config)
+		float evaluationInterval = 0.2f;
+
+	void RegisterActor(AActor* actor, FOnSignificanceTierChanged onTierChanged = FOnSignificanceTierChanged(), FGetSignificanceLocation getLocation = FGetSignificanceLocation(), bool bCanGoDormant = true);
+	void UnregisterActor(AActor* actor);
+
+	/** Tick interval of the tier, negative for Dormant. */
+	float GetTierTickInterval(ESignificanceTier tier) const;
+
+	UFUNCTION(BlueprintPure)
+		int32 GetTierCount(ESignificanceTier tier) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	// End of FTickableGameObject
+
+private:
+	ESignificanceTier ComputeTier(FSignificanceEntry& entry, const FVector& viewLocation, const FVector& viewDirection) const;
+	void ApplyTier(FSignificanceEntry& entry);
+	void UpdateStats();
+
+	TArray<FSignificanceEntry> entries;
+	int32 tierCounts[(int32)ESignificanceTier::Count] = {};
+	float timeUntilEvaluation = 0.0f;
+	bool bHasRemovedEntries = false;
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TargetPlacementEngine.h"
+
+FTargetPlacementEngine::FTargetPlacementEngine(const FBox2D& inArea, float inMinSeparation, int32 seed)
+	: area(inArea)
+	, minSeparation(FMath::Max(inMinSeparation, KINDA_SMALL_NUMBER))
+	, randomStream(seed)
+{
+	cellSize = minSeparation / UE_SQRT_2;
+}
+
+void FTargetPlacementEngine::AddExclusionBox(const FBox2D& box)
+{
+	exclusionBoxes.Add(box);
+}
+
+void FTargetPlacementEngine::AddExclusionCircle(const FVector2D& center, float radius)
+{
+	exclusionCircles.Add(FVector4(center.X, center.Y, radius * radius, 0.0f));
+}
+
+int32 FTargetPlacementEngine::GeneratePositions(int32 count, TArray<FVector2D>& outPositions)
+{
+	points.Reset();
+	activePoints.Reset();
+	spatialHash.Reset();
+	points.Reserve(count);
+	spatialHash.Reserve(count);
+
+	while (points.Num() < count)
+	{
+		if (activePoints.Num() == 0)
+		{
+			// Zonas separadas por exclusiones necesitan su propio punto inicial
+			if (!TryAddRandomSeedPoint())
+			{
+				break;
+			}
+			continue;
+		}
+
+		const int32 activeIndex = randomStream.RandHelper(activePoints.Num());
+		const FVector2D origin = points[activePoints[activeIndex]];
+		bool bFound = false;
+		for (int32 attempt = 0; attempt < CandidatesPerPoint; attempt++)
+		{
+			const float angle = randomStream.FRandRange(0.0f, 2.0f * PI);
+			const float distance = randomStream.FRandRange(minSeparation, 2.0f * minSeparation);
+			const FVector2D candidate = origin + FVector2D(FMath::Cos(angle), FMath::Sin(angle)) * distance;
+			if (area.IsInside(candidate) && !IsExcluded(candidate) && IsFarFromNeighbours(candidate))
+			{
+				AddPoint(candidate);
+				bFound = true;
+				break;
+			}
+		}
+		if (!bFound)
+		{
+			activePoints.RemoveAtSwap(activeIndex, 1, false);
+		}
+	}
+
+	outPositions.Append(points);
+	return points.Num();
+}
+
+FIntPoint FTargetPlacementEngine::GetCell(const FVector2D& point) const
+{
+	return FIntPoint(FMath::FloorToInt((point.X - area.Min.X) / cellSize), FMath::FloorToInt((point.Y - area.Min.Y) / cellSize));
+}
+
+bool FTargetPlacementEngine::IsExcluded(const FVector2D& point) const
+{
+	for (const FBox2D& box : exclusionBoxes)
+	{
+		if (box.IsInside(point))
+		{
+			return true;
+		}
+	}
+	for (const FVector4& circle : exclusionCircles)
+	{
+		if (FVector2D::DistSquared(point, FVector2D(circle.X, circle.Y)) < circle.Z)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FTargetPlacementEngine::IsFarFromNeighbours(const FVector2D& point) const
+{
+	// Con celdas de separacion / sqrt(2) alcanza con revisar dos celdas hacia cada lado
+	const FIntPoint cell = GetCell(point);
+	const float minSeparationSquared = minSeparation * minSeparation;
+	for (int32 y = cell.Y - 2; y <= cell.Y + 2; y++)
+	{
+		for (int32 x = cell.X - 2; x <= cell.X + 2; x++)
+		{
+			const int32* neighbour = spatialHash.Find(FIntPoint(x, y));
+			if (neighbour != nullptr && FVector2D::DistSquared(point, points[*neighbour]) < minSeparationSquared)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool FTargetPlacementEngine::TryAddRandomSeedPoint()
+{
+	for (int32 attempt = 0; attempt < CandidatesPerPoint; attempt++)
+	{
+		const FVector2D candidate(randomStream.FRandRange(area.Min.X, area.Max.X), randomStream.FRandRange(area.Min.Y, area.Max.Y));
+		if (!IsExcluded(candidate) && IsFarFromNeighbours(candidate))
+		{
+			AddPoint(candidate);
+			return true;
+		}
+	}
+	return false;
+}
+
+void FTargetPlacementEngine::AddPoint(const FVector2D& point)
+{
+	const int32 index = points.Add(point);
+	activePoints.Add(index);
+	spatialHash.Add(GetCell(point), index);
+}
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/**
+ * Places points on a rectangle with Poisson-disk sampling (Bridson) so that no two points are
+ * closer than a minimum separation. Neighbours are found through a spatial hash of cells of
+ * size separation / sqrt(2), which holds at most one point each, so generation is linear in
+ * the number of points. The same seed always gives the same points.
+ */
+class DUALCOMBATCOLOR_FPS_API FTargetPlacementEngine
+{
+public:
+	FTargetPlacementEngine(const FBox2D& inArea, float inMinSeparation, int32 seed);
+
+	/** Points inside the box are rejected. */
+	void AddExclusionBox(const FBox2D& box);
+
+	/** Points closer than radius to the center are rejected. */
+	void AddExclusionCircle(const FVector2D& center, float radius);
+
+	/**
+	 * Appends up to count points to outPositions.
+	 * @returns the number of points generated, less than count if the area is full.
+	 */
+	int32 GeneratePositions(int32 count, TArray<FVector2D>& outPositions);
+
+	FORCEINLINE FRandomStream& GetRandomStream() { return randomStream; }
+
+private:
+	FIntPoint GetCell(const FVector2D& point) const;
+	bool IsExcluded(const FVector2D& point) const;
+	bool IsFarFromNeighbours(const FVector2D& point) const;
+	bool TryAddRandomSeedPoint();
+	void AddPoint(const FVector2D& point);
+
+	// Candidatos probados alrededor de cada punto activo antes de descartarlo (valor de Bridson)
+	static constexpr int32 CandidatesPerPoint = 30;
+
+	FBox2D area;
+	float minSeparation;
+	float cellSize;
+	FRandomStream randomStream;
+
+	TArray<FBox2D> exclusionBoxes;
+	TArray<FVector4> exclusionCircles;
+
+	TArray<FVector2D> points;
+	TArray<int32> activePoints;
+	TMap<FIntPoint, int32> spatialHash;
+};
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UILayerSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Blueprint/WidgetTree.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_STATS_GROUP(TEXT("UILayer"), STATGROUP_UILayer, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Resident user widgets"), STAT_UILayerResident, STATGROUP_UILayer);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Resident tree widgets"), STAT_UILayerResidentTreeWidgets, STATGROUP_UILayer);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Widget creation ms"), STAT_UILayerCreationMs, STATGROUP_UILayer);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Level start UI ms"), STAT_UILayerLevelStartMs, STATGROUP_UILayer);
+
+void UUILayerSubsystem::Deinitialize()
+{
+	LogStats();
+	for (TPair<UClass*, UUserWidget*>& pair : widgets)
+	{
+		if (pair.Value != nullptr)
+		{
+			pair.Value->RemoveFromParent();
+		}
+	}
+	widgets.Empty();
+	Super::Deinitialize();
+}
+
+UUserWidget* UUILayerSubsystem::GetOrCreateWidget(TSubclassOf<UUserWidget> widgetClass)
+{
+	if (widgetClass == nullptr)
+	{
+		return nullptr;
+	}
+	UUserWidget** existing = widgets.Find(widgetClass);
+	if (existing != nullptr && *existing != nullptr)
+	{
+		stats.reused++;
+		return *existing;
+	}
+
+	const double startTime = FPlatformTime::Seconds();
+	// El dueño es la GameInstance para que el widget no se destruya al cambiar de nivel
+	UUserWidget* widget = CreateWidget<UUserWidget>(GetGameInstance(), widgetClass);
+	if (widget == nullptr)
+	{
+		return nullptr;
+	}
+	const float elapsedMs = (float)((FPlatformTime::Seconds() - startTime) * 1000.0);
+
+	int32 treeWidgets = 0;
+	if (widget->WidgetTree != nullptr)
+	{
+		widget->WidgetTree->ForEachWidget([&treeWidgets](UWidget*) { treeWidgets++; });
+	}
+	widgets.Add(widgetClass, widget);
+	stats.created++;
+	stats.resident = widgets.Num();
+	stats.residentTreeWidgets += treeWidgets;
+	stats.creationMs += elapsedMs;
+
+	SET_DWORD_STAT(STAT_UILayerResident, stats.resident);
+	SET_DWORD_STAT(STAT_UILayerResidentTreeWidgets, stats.residentTreeWidgets);
+	INC_FLOAT_STAT_BY(STAT_UILayerCreationMs, elapsedMs);
+	return widget;
+}
+
+UUserWidget* UUILayerSubsystem::ShowWidgetInternal(TSubclassOf<UUserWidget> widgetClass, int32 zOrder)
+{
+	UUserWidget* widget = GetOrCreateWidget(widgetClass);
+	if (widget == nullptr)
+	{
+		return nullptr;
+	}
+	// Al cambiar de nivel el widget se saca del viewport, se vuelve a agregar al mostrarlo
+	if (!widget->IsInViewport())
+	{
+		widget->AddToViewport(zOrder);
+	}
+	widget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+	return widget;
+}
+
+void UUILayerSubsystem::CollapseWidget(UUserWidget* widget)
+{
+	if (widget != nullptr)
+	{
+		widget->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void UUILayerSubsystem::RecordLevelStart(float milliseconds)
+{
+	stats.levelStarts++;
+	stats.lastLevelStartMs = milliseconds;
+	stats.maxLevelStartMs = FMath::Max(stats.maxLevelStartMs, milliseconds);
+	SET_FLOAT_STAT(STAT_UILayerLevelStartMs, milliseconds);
+}
+
+FUILayerStats UUILayerSubsystem::GetStats() const
+{
+	return stats;
+}
+
+void UUILayerSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("UILayer: created %d, reused %d, resident %d (%d tree widgets), creation %.2f ms, %d level starts (last %.2f ms, max %.2f ms)"),
+		stats.created, stats.reused, stats.resident, stats.residentTreeWidgets, stats.creationMs,
+		stats.levelStarts, stats.lastLevelStartMs, stats.maxLevelStartMs);
+}
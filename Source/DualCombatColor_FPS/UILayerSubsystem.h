@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "UILayerSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FUILayerStats
+{
+	GENERATED_BODY()
+public:
+	/** User widgets created since the game started. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 created = 0;
+	/** Requests served by an already created widget. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 reused = 0;
+	/** User widgets currently kept alive by the subsystem. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 resident = 0;
+	/** Widgets in the trees of the resident user widgets. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 residentTreeWidgets = 0;
+	/** Time spent creating widgets, in milliseconds. */
+	UPROPERTY(BlueprintReadOnly)
+		float creationMs = 0.0f;
+	/** Levels started since the game started. */
+	UPROPERTY(BlueprintReadOnly)
+		int32 levelStarts = 0;
+	/** Time the last level start spent building and showing its widgets, in milliseconds. */
+	UPROPERTY(BlueprintReadOnly)
+		float lastLevelStartMs = 0.0f;
+	/** Slowest level start, in milliseconds. */
+	UPROPERTY(BlueprintReadOnly)
+		float maxLevelStartMs = 0.0f;
+};
+
+/**
+ * Owns the HUD and menu widgets for the whole game. Widgets are created on first use with
+ * the game instance as owner, so they survive OpenLevel, and are added back to the viewport
+ * of the new level the next time they are shown. Hidden widgets are collapsed so they do not
+ * take part in layout.
+ */
+UCLASS()
+class DUALCOMBATCOLOR_FPS_API UUILayerSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	/** Returns the widget of the class, creating it the first time. It is not added to the viewport. */
+	template<class T>
+	T* GetWidget(TSubclassOf<T> widgetClass)
+	{
+		return Cast<T>(GetOrCreateWidget(widgetClass));
+	}
+
+	/** Creates the widget if needed, adds it to the viewport of the current level and makes it visible. */
+	template<class T>
+	T* ShowWidget(TSubclassOf<T> widgetClass, int32 zOrder = 0)
+	{
+		return Cast<T>(ShowWidgetInternal(widgetClass, zOrder));
+	}
+
+	/** Collapses the widget, it stays in the viewport and in memory. */
+	void CollapseWidget(UUserWidget* widget);
+
+	/** Records the time a level start spent on its widgets. Called once per level by the player character. */
+	void RecordLevelStart(float milliseconds);
+
+	UFUNCTION(BlueprintPure)
+		FUILayerStats GetStats() const;
+
+	void LogStats() const;
+
+private:
+	UUserWidget* GetOrCreateWidget(TSubclassOf<UUserWidget> widgetClass);
+	UUserWidget* ShowWidgetInternal(TSubclassOf<UUserWidget> widgetClass, int32 zOrder);
+
+	UPROPERTY()
+		TMap<UClass*, UUserWidget*> widgets;
+
+	UPROPERTY()
+		FUILayerStats stats;
+};
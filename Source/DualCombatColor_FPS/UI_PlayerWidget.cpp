@@ -4,37 +4,59 @@
 #include "UI_PlayerWidget.h"
 #include "Components/TextBlock.h"
 #include "Components/Widget.h"
+#include "Widgets/SInvalidationPanel.h"
 
-void UUI_PlayerWidget::SetScoreText(int _score)
+TSharedRef<SWidget> UUI_PlayerWidget::RebuildWidget()
 {
-	if (textScore != nullptr)
+	TSharedRef<SWidget> content = Super::RebuildWidget();
+	if (!bUseInvalidationPanel || IsDesignTime())
 	{
-		textScore->SetText(FText::FromString("Score: "));
+		return content;
+	}
+	// Solo se vuelve a pintar cuando cambia un texto
+	return SNew(SInvalidationPanel)
+		[
+			content
+		];
+}
 
-		FString text = FString::Printf(TEXT("%s %i"), *textScore->Text.ToString(), _score);
+void UUI_PlayerWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+	// Al volver al viewport en otro nivel los textos se escriben de nuevo
+	viewModel.MarkAllDirty();
+}
 
-		textScore->SetText(FText::FromString(text));
+void UUI_PlayerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+	if (!viewModel.HasDirtyFields())
+	{
+		return;
 	}
+	FlushField(EHUDField::Score, textScore);
+	FlushField(EHUDField::Level, textCurrentLevel);
+	FlushField(EHUDField::Life, textCurrentLife);
+	viewModel.ClearDirty();
 }
-void UUI_PlayerWidget::SetCurrentLevelText(int _currentLevel)
+
+void UUI_PlayerWidget::FlushField(EHUDField field, UTextBlock* textBlock)
 {
-	if (textCurrentLevel != nullptr)
+	if (textBlock != nullptr && viewModel.IsDirty(field))
 	{
-		textCurrentLevel->SetText(FText::FromString("Level "));
-
-		FString text = FString::Printf(TEXT("%s %i"), *textCurrentLevel->Text.ToString(), _currentLevel);
-
-		textCurrentLevel->SetText(FText::FromString(text));
+		textBlock->SetText(viewModel.ConsumeText(field));
 	}
 }
+
+void UUI_PlayerWidget::SetScoreText(int _score)
+{
+	viewModel.SetValue(EHUDField::Score, _score);
+}
+void UUI_PlayerWidget::SetCurrentLevelText(int _currentLevel)
+{
+	viewModel.SetValue(EHUDField::Level, _currentLevel);
+}
 void UUI_PlayerWidget::SetCurrentLifeText(int _currentLife)
 {
-	if (textCurrentLife != nullptr)
-	{
-		textCurrentLife->SetText(FText::FromString("Life: "));
-
-		FString text = FString::Printf(TEXT("%s %i"), *textCurrentLife->Text.ToString(), _currentLife);
-
-		textCurrentLife->SetText(FText::FromString(text));
-	}
-}
\ No newline at end of file
+	viewModel.SetValue(EHUDField::Life, _currentLife);
+}
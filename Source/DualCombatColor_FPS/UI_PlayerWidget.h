@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "HUDViewModel.h"
 #include "UI_PlayerWidget.generated.h"
 
 /**
- * 
+ * Player HUD. The Set functions only update the view-model; the text blocks are refreshed
+ * at most once per frame in NativeTick, however many hits arrive in that frame. The root is
+ * wrapped in an invalidation panel, so frames where no text changed reuse the cached paint.
  */
 UCLASS()
 class DUALCOMBATCOLOR_FPS_API UUI_PlayerWidget : public UUserWidget
@@ -22,8 +25,22 @@ protected:
 
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 		class UTextBlock* textCurrentLife;
+
+	FHUDViewModel viewModel;
+
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	void FlushField(EHUDField field, class UTextBlock* textBlock);
 public:
+	/** Caches the HUD paint in an SInvalidationPanel. Only read when the Slate widget is built. */
+	UPROPERTY(EditAnywhere, Category = "Performance")
+		bool bUseInvalidationPanel = true;
+
 	void SetScoreText(int _score);
 	void SetCurrentLevelText(int _currentLevel);
 	void SetCurrentLifeText(int _currentLife);
+
+	FORCEINLINE const FHUDViewModel& GetViewModel() const { return viewModel; }
 };
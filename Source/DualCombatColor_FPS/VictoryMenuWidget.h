@@ -27,8 +27,12 @@ protected:
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget))
 		class UWidget* CanvasVictoryMenu;
 
+	/** Text of textYouScore from the designer, so the score is not appended twice when the menu is shown again after a Retry. */
+	FText scoreLabel;
+
 public:
 	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
 	virtual void NativeDestruct() override;
 
 	void ActivateMe();
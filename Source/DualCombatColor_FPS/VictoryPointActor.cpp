@@ -4,9 +4,13 @@
 #include "VictoryPointActor.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "UObject/SoftObjectPtr.h"
-#include "AssetLoaderManager.h"
+#include "AssetStreamingSubsystem.h"
 #include "kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "SignificanceTickSubsystem.h"
+#include "ParkourGameInstance.h"
+#include "TimerManager.h"
+#include "GameFramework/Pawn.h"
 
 // Sets default values
 AVictoryPointActor::AVictoryPointActor()
@@ -25,10 +29,31 @@ void AVictoryPointActor::BeginPlay()
 		SetActorLocation(InitialPosition);
 		SetActorRotation(InitialRotation);
 	}
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->RegisterActor(this);
+	}
 
-	AAssetLoaderManager* AssetLoader = Cast<AAssetLoaderManager>(AAssetLoaderManager::StaticClass()->GetDefaultObject());
-	AssetLoader->AddAssetToLoad(MeshTP);
-	AssetLoader->OnAssetsLoadedDelegate.AddUObject(this, &AVictoryPointActor::OnAssetLoadingComplete);
+	UParkourGameInstance* parkourGameInstance = Cast<UParkourGameInstance>(GetGameInstance());
+	const FLevelCatalogEntry* nextLevelEntry = (parkourGameInstance != nullptr) ? parkourGameInstance->GetNextLevelEntry() : nullptr;
+	if (nextLevelEntry != nullptr)
+	{
+		nextLevel = *nextLevelEntry;
+		bHasNextLevel = true;
+		GetWorldTimerManager().SetTimer(preloadTimerHandle, this, &AVictoryPointActor::CheckPreloadDistance, preloadCheckInterval, true);
+	}
+
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming != nullptr)
+	{
+		meshRequestId = streaming->RequestAsset(MeshTP_Ptr.ToSoftObjectPath(), FOnAssetRequestComplete::CreateUObject(this, &AVictoryPointActor::OnAssetLoadingComplete));
+	}
+}
+
+EGameplayRole AVictoryPointActor::GetGameplayRoles() const
+{
+	return EGameplayRole::VictoryPoint | IGameplayRoleActor::GetRolesFromTags(this);
 }
 
 void AVictoryPointActor::OnAssetLoadingComplete()
@@ -47,6 +72,40 @@ void AVictoryPointActor::OnAssetLoadingComplete()
 	}
 }
 
+void AVictoryPointActor::CheckPreloadDistance()
+{
+	APawn* playerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (playerPawn == nullptr)
+	{
+		return;
+	}
+	if (FVector::DistSquared(playerPawn->GetActorLocation(), GetActorLocation()) <= FMath::Square(nextLevel.preloadDistance))
+	{
+		UParkourGameInstance* parkourGameInstance = Cast<UParkourGameInstance>(GetGameInstance());
+		if (parkourGameInstance != nullptr)
+		{
+			parkourGameInstance->PreloadLevel(nextLevel.level);
+		}
+		GetWorldTimerManager().ClearTimer(preloadTimerHandle);
+	}
+}
+
+void AVictoryPointActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(preloadTimerHandle);
+	UAssetStreamingSubsystem* streaming = GetGameInstance()->GetSubsystem<UAssetStreamingSubsystem>();
+	if (streaming != nullptr)
+	{
+		streaming->ReleaseRequest(meshRequestId);
+	}
+	USignificanceTickSubsystem* significance = GetWorld()->GetSubsystem<USignificanceTickSubsystem>();
+	if (significance != nullptr)
+	{
+		significance->UnregisterActor(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AVictoryPointActor::Tick(float DeltaTime)
 {
@@ -55,6 +114,12 @@ void AVictoryPointActor::Tick(float DeltaTime)
 }
 void AVictoryPointActor::LoadNextLevel() 
 {
-		UGameplayStatics::OpenLevel(this, nameMap);
+	UParkourGameInstance* parkourGameInstance = Cast<UParkourGameInstance>(GetGameInstance());
+	if (bHasNextLevel && parkourGameInstance != nullptr)
+	{
+		parkourGameInstance->TravelToLevel(nextLevel);
+		return;
+	}
+	UGameplayStatics::OpenLevel(this, nameMap);
 }
 
@@ -4,20 +4,25 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "LevelCatalog.h"
+#include "GameplayRoleActor.h"
 #include "VictoryPointActor.generated.h"
 
 class USkeletalMeshComponent;
 class USkeletalMesh;
 
 UCLASS()
-class DUALCOMBATCOLOR_FPS_API AVictoryPointActor : public AActor
+class DUALCOMBATCOLOR_FPS_API AVictoryPointActor : public AActor, public IGameplayRoleActor
 {
 	GENERATED_BODY()
+
 	
 public:	
 	// Sets default values for this actor's properties
 	AVictoryPointActor();
 
+	virtual EGameplayRole GetGameplayRoles() const override;
+
 	UPROPERTY(EditAnywhere)
 		USkeletalMeshComponent* MeshTP;
 
@@ -33,15 +38,30 @@ public:
 	UPROPERTY(EditAnywhere)
 		FRotator InitialRotation;
 
+	/** Map opened when the current level is not in the game instance level catalog. */
 	UPROPERTY(EditAnywhere)
 		FName nameMap;
+
+	/** Seconds between checks of the player distance for preloading the next level. */
+	UPROPERTY(EditAnywhere)
+		float preloadCheckInterval = 0.25f;
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	UFUNCTION()
 		void OnAssetLoadingComplete();
 
+	void CheckPreloadDistance();
+
+	FLevelCatalogEntry nextLevel;
+	bool bHasNextLevel = false;
+	FTimerHandle preloadTimerHandle;
+
+	int32 meshRequestId = INDEX_NONE;
+
 	
 public:	
 	// Called every frame